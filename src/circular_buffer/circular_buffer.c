@@ -1,119 +1,301 @@
+#include <string.h>
+
+// The hot path operations live in circular_buffer_inline.h. Emit their one
+// out-of-line definition here unless they are built static inline.
+#define CIRCULAR_BUFFER_DEFINE_HOT_PATH
 #include "circular_buffer.h"
 
-// Defensive check: head should always stay within buffer bounds,
-// but we verify to guard against potential corruption/misuse.
-static bool ctx_is_valid(const circular_buffer_ctx *ctx) {
-    return ctx &&
-           ctx->buff_size <= CIRCULAR_BUFFER_MAX_SIZE &&
-           ctx->buff_size > 0 &&
-           ctx->head < ctx->buff_size &&
-           ctx->tail < ctx->buff_size &&
-           ctx->current_byte_count <= ctx->buff_size;
+// Wraps an index that is known to be less than twice the buffer size.
+// Cheaper than the modulo for offsets that have already been bounds checked.
+static size_t wrap_index(const circular_buffer_ctx *ctx, size_t index)
+{
+    return (index >= ctx->buff_size) ? (index - ctx->buff_size) : index;
+}
+
+// Copies len bytes in at head, splitting the copy at the end of the storage.
+// Caller guarantees that len fits in the free space.
+static void copy_in(circular_buffer_ctx *ctx, const uint8_t *src, size_t len)
+{
+    size_t first_len = ctx->buff_size - ctx->head;
+
+    if (first_len > len)
+    {
+        first_len = len;
+    }
+
+    memcpy(&ctx->buffer[ctx->head], src, first_len);
+    memcpy(&ctx->buffer[0], src + first_len, len - first_len);
+
+    ctx->head = wrap_index(ctx, ctx->head + len);
+    ctx->current_byte_count += len;
+}
+
+// Copies len bytes out, starting offset bytes after tail, splitting the copy at the end
+// of the storage. Caller guarantees that offset + len bytes are present. Does not consume anything.
+static void copy_out(const circular_buffer_ctx *ctx, uint8_t *dst, size_t offset, size_t len)
+{
+    size_t start = wrap_index(ctx, ctx->tail + offset);
+    size_t first_len = ctx->buff_size - start;
+
+    if (first_len > len)
+    {
+        first_len = len;
+    }
+
+    memcpy(dst, &ctx->buffer[start], first_len);
+    memcpy(dst + first_len, &ctx->buffer[0], len - first_len);
+}
+
+// Removes the len oldest bytes in constant time. Caller guarantees that len bytes are present.
+static void drop_oldest(circular_buffer_ctx *ctx, size_t len)
+{
+    ctx->tail = wrap_index(ctx, ctx->tail + len);
+    ctx->current_byte_count -= len;
+    CIRCULAR_BUFFER_STATS(ctx->stats.bytes_popped += len;)
+    CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_remove(ctx, len);)
+    circular_buffer_check_watermarks(ctx);
 }
 
 bool circular_buffer_init(circular_buffer_ctx *ctx, size_t buff_size)
 {
     bool res = false;
 
-    if (ctx && 0 < buff_size && buff_size <= CIRCULAR_BUFFER_MAX_SIZE)
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    if (ctx && buff_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        res = circular_buffer_init_with_storage(ctx, ctx->storage, buff_size);
+    }
+#else
+    (void)ctx;
+    (void)buff_size;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_init_with_storage(circular_buffer_ctx *ctx, uint8_t *mem, size_t len)
+{
+    bool res = false;
+
+    // Index math adds offsets of up to buff_size to an index, which must not overflow.
+    if (ctx && mem && 0 < len && len <= SIZE_MAX / 2)
     {
-        ctx->buff_size = buff_size;
+        ctx->buff_size = len;
+        ctx->buffer = mem;
         ctx->head = 0;
         ctx->tail = 0;
         ctx->current_byte_count = 0;
         ctx->overflow_count = 0;
+        ctx->high_watermark = 0;
+        ctx->low_watermark = 0;
+        ctx->watermark_cb = NULL;
+        ctx->watermark_arg = NULL;
+        ctx->above_high = false;
+        CIRCULAR_BUFFER_STATS(memset(&ctx->stats, 0, sizeof(ctx->stats));)
+        CIRCULAR_BUFFER_LATENCY(memset(&ctx->latency, 0, sizeof(ctx->latency));)
         res = true;
     }
 
     return res;
 }
 
-bool circular_buffer_push_with_overwrite(circular_buffer_ctx *ctx, uint8_t data)
+bool circular_buffer_write(circular_buffer_ctx *ctx, const uint8_t *src, size_t len, bool overwrite)
 {
     bool res = false;
 
-    if (ctx_is_valid(ctx))
+    if (src && circular_buffer_ctx_is_valid(ctx) &&
+        (overwrite || len <= ctx->buff_size - ctx->current_byte_count))
     {
-        // Buffer is full if true, overwrite mode.
-        if (ctx->current_byte_count == ctx->buff_size)
+        size_t free_space = ctx->buff_size - ctx->current_byte_count;
+        CIRCULAR_BUFFER_STATS(size_t pushed = len;)
+        CIRCULAR_BUFFER_LATENCY(size_t latency_pushed = len; size_t latency_removed = 0;)
+
+        // Overwrite mode. Drop the oldest bytes to make room, exactly as len
+        // calls to circular_buffer_push_with_overwrite would have.
+        if (len > free_space)
         {
-            ctx->tail = (ctx->tail + 1) % ctx->buff_size;
-            ctx->current_byte_count--;
-            ctx->overflow_count++;
+            size_t dropped = len - free_space;
+            ctx->overflow_count += (uint32_t)dropped;
+            CIRCULAR_BUFFER_STATS(ctx->stats.bytes_overwritten += dropped;)
+            CIRCULAR_BUFFER_LATENCY(latency_removed = dropped;)
+
+            if (len > ctx->buff_size)
+            {
+                // Only the newest buff_size bytes survive, so skip copying the rest.
+                size_t skipped = len - ctx->buff_size;
+                src += skipped;
+                len = ctx->buff_size;
+                ctx->head = (ctx->head + skipped) % ctx->buff_size;
+                ctx->tail = ctx->head;
+                ctx->current_byte_count = 0;
+            }
+            else
+            {
+                ctx->tail = wrap_index(ctx, ctx->tail + dropped);
+                ctx->current_byte_count -= dropped;
+            }
         }
 
-        ctx->buffer[ctx->head] = data;
-        ctx->head = (ctx->head + 1) % ctx->buff_size;
-        ctx->current_byte_count++;
+        copy_in(ctx, src, len);
+        CIRCULAR_BUFFER_STATS(circular_buffer_stats_add_pushed(ctx, pushed);)
+        // The dropped bytes were all stored before this write, so they are retired after it is
+        // timestamped. Bytes skipped in the len > buff_size case count as added and removed.
+        CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_push(ctx, latency_pushed);)
+        CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_remove(ctx, latency_removed);)
+        circular_buffer_check_watermarks(ctx);
+        res = true;
+    }
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+    else if (src && circular_buffer_ctx_is_valid(ctx))
+    {
+        ctx->stats.rejected_pushes++;
+    }
+#endif
+
+    return res;
+}
+
+bool circular_buffer_read(circular_buffer_ctx *ctx, uint8_t *dst, size_t len)
+{
+    bool res = false;
+
+    if (dst && circular_buffer_ctx_is_valid(ctx) && len <= ctx->current_byte_count)
+    {
+        copy_out(ctx, dst, 0, len);
+        drop_oldest(ctx, len);
+        res = true;
+    }
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+    else if (dst && circular_buffer_ctx_is_valid(ctx) && ctx->current_byte_count == 0)
+    {
+        ctx->stats.empty_pops++;
+    }
+#endif
+
+    return res;
+}
+
+bool circular_buffer_peek_at(const circular_buffer_ctx *ctx, size_t offset, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && circular_buffer_ctx_is_valid(ctx) && offset < ctx->current_byte_count)
+    {
+        *data = ctx->buffer[wrap_index(ctx, ctx->tail + offset)];
+        res = true;
+    }
+
+    return res;
+}
 
+bool circular_buffer_peek_range(const circular_buffer_ctx *ctx, size_t offset, uint8_t *dst, size_t len)
+{
+    bool res = false;
+
+    // Written so that offset + len cannot overflow.
+    if (dst && circular_buffer_ctx_is_valid(ctx) &&
+        len <= ctx->current_byte_count && offset <= ctx->current_byte_count - len)
+    {
+        copy_out(ctx, dst, offset, len);
         res = true;
     }
 
     return res;
 }
 
-bool circular_buffer_push_no_overwrite(circular_buffer_ctx *ctx, uint8_t data)
+// Free space runs from head up to tail, or to the end of storage if tail is behind head.
+// Only meaningful when the buffer is not full.
+static size_t contiguous_free(const circular_buffer_ctx *ctx)
+{
+    return (ctx->head < ctx->tail) ? (ctx->tail - ctx->head) : (ctx->buff_size - ctx->head);
+}
+
+bool circular_buffer_reserve(circular_buffer_ctx *ctx, uint8_t **ptr, size_t *len)
 {
     bool res = false;
 
-    if (ctx_is_valid(ctx) && ctx->current_byte_count < ctx->buff_size)
+    if (ptr && len && circular_buffer_ctx_is_valid(ctx) && ctx->current_byte_count < ctx->buff_size)
     {
-        ctx->buffer[ctx->head] = data;
-        ctx->head = (ctx->head + 1) % ctx->buff_size;
-        ctx->current_byte_count++;
+        // Nothing is stored, so start over at the front and offer all of it.
+        if (ctx->current_byte_count == 0)
+        {
+            ctx->head = 0;
+            ctx->tail = 0;
+        }
 
+        *ptr = &ctx->buffer[ctx->head];
+        *len = contiguous_free(ctx);
         res = true;
     }
 
     return res;
 }
 
-bool circular_buffer_pop(circular_buffer_ctx *ctx, uint8_t *data)
+bool circular_buffer_commit(circular_buffer_ctx *ctx, size_t len)
 {
     bool res = false;
 
-    if (data && ctx_is_valid(ctx) && ctx->current_byte_count > 0)
+    // Never past the region reserve offers, so bytes that were not written are never published.
+    if (circular_buffer_ctx_is_valid(ctx) && len <= ctx->buff_size - ctx->current_byte_count &&
+        len <= contiguous_free(ctx))
     {
-        *data = ctx->buffer[ctx->tail];
-        ctx->tail = (ctx->tail + 1) % ctx->buff_size;
-        ctx->current_byte_count -= 1;
+        ctx->head = wrap_index(ctx, ctx->head + len);
+        ctx->current_byte_count += len;
+        CIRCULAR_BUFFER_STATS(circular_buffer_stats_add_pushed(ctx, len);)
+        CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_push(ctx, len);)
+        circular_buffer_check_watermarks(ctx);
         res = true;
     }
 
     return res;
 }
 
-bool circular_buffer_peek(const circular_buffer_ctx *ctx, uint8_t *data)
+bool circular_buffer_peek_contiguous(const circular_buffer_ctx *ctx, const uint8_t **ptr, size_t *len)
 {
     bool res = false;
 
-    if (data && ctx_is_valid(ctx) && ctx->current_byte_count > 0)
+    if (ptr && len && circular_buffer_ctx_is_valid(ctx) && ctx->current_byte_count > 0)
     {
-        *data = ctx->buffer[ctx->tail];
+        size_t contiguous_len = ctx->buff_size - ctx->tail;
+
+        *ptr = &ctx->buffer[ctx->tail];
+        *len = (ctx->current_byte_count < contiguous_len) ? ctx->current_byte_count : contiguous_len;
         res = true;
     }
 
     return res;
 }
 
-bool circular_buffer_is_empty(const circular_buffer_ctx *ctx)
+bool circular_buffer_consume(circular_buffer_ctx *ctx, size_t len)
 {
-    bool res = true; // Consider a NULL ctx to be an empty buffer.
+    bool res = false;
 
-    if (ctx_is_valid(ctx) && ctx->current_byte_count > 0)
+    if (circular_buffer_ctx_is_valid(ctx) && len <= ctx->current_byte_count)
     {
-        res = false;
+        drop_oldest(ctx, len);
+        res = true;
     }
 
     return res;
 }
 
-bool circular_buffer_is_full(const circular_buffer_ctx *ctx)
+bool circular_buffer_skip(circular_buffer_ctx *ctx, size_t len)
+{
+    return circular_buffer_consume(ctx, len);
+}
+
+bool circular_buffer_clear(circular_buffer_ctx *ctx)
 {
     bool res = false;
 
-    if (ctx_is_valid(ctx) && ctx->current_byte_count == ctx->buff_size)
+    if (circular_buffer_ctx_is_valid(ctx))
     {
+        CIRCULAR_BUFFER_STATS(ctx->stats.bytes_popped += ctx->current_byte_count;)
+        CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_remove(ctx, ctx->current_byte_count);)
+        ctx->head = 0;
+        ctx->tail = 0;
+        ctx->current_byte_count = 0;
+        circular_buffer_check_watermarks(ctx);
         res = true;
     }
 
@@ -124,7 +306,7 @@ bool circular_buffer_get_current_capacity(const circular_buffer_ctx *ctx, size_t
 {
     bool res = false;
 
-    if (capacity && ctx_is_valid(ctx))
+    if (capacity && circular_buffer_ctx_is_valid(ctx))
     {
         *capacity = ctx->buff_size - ctx->current_byte_count;
         res = true;
@@ -137,7 +319,7 @@ bool circular_buffer_get_overflow_count(const circular_buffer_ctx *ctx, uint32_t
 {
     bool res = false;
 
-    if (overflow_count && ctx_is_valid(ctx))
+    if (overflow_count && circular_buffer_ctx_is_valid(ctx))
     {
         *overflow_count = ctx->overflow_count;
         res = true;
@@ -150,7 +332,7 @@ bool circular_buffer_clear_overflow_count(circular_buffer_ctx *ctx)
 {
     bool res = false;
 
-    if (ctx_is_valid(ctx))
+    if (circular_buffer_ctx_is_valid(ctx))
     {
         ctx->overflow_count = 0;
         res = true;
@@ -158,3 +340,211 @@ bool circular_buffer_clear_overflow_count(circular_buffer_ctx *ctx)
 
     return res;
 }
+
+bool circular_buffer_get_stats(const circular_buffer_ctx *ctx, circular_buffer_stats *stats)
+{
+    bool res = false;
+
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+    if (stats && circular_buffer_ctx_is_valid(ctx))
+    {
+        *stats = ctx->stats;
+        res = true;
+    }
+#else
+    (void)ctx;
+    (void)stats;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_get_and_clear_stats(circular_buffer_ctx *ctx, circular_buffer_stats *stats)
+{
+    bool res = false;
+
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+    if (stats && circular_buffer_ctx_is_valid(ctx))
+    {
+        *stats = ctx->stats;
+        memset(&ctx->stats, 0, sizeof(ctx->stats));
+        ctx->stats.high_water = ctx->current_byte_count;
+        res = true;
+    }
+#else
+    (void)ctx;
+    (void)stats;
+#endif
+
+    return res;
+}
+
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+// Index of the histogram bucket for a residency of ticks: 0 for 0, otherwise one more than
+// the position of the highest set bit, saturating at the last bucket.
+static size_t latency_bucket(uint64_t ticks)
+{
+    size_t bucket = 0;
+
+    while (ticks > 0 && bucket < CIRCULAR_BUFFER_LATENCY_BUCKETS - 1)
+    {
+        ticks >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+static void latency_record(circular_buffer_latency_histogram *histogram, uint64_t ticks)
+{
+    histogram->buckets[latency_bucket(ticks)]++;
+    histogram->samples++;
+    if (ticks > histogram->max)
+    {
+        histogram->max = ticks;
+    }
+}
+
+void circular_buffer_latency_on_push(circular_buffer_ctx *ctx, size_t len)
+{
+    circular_buffer_latency *latency = &ctx->latency;
+
+    if (latency->clock && len > 0 && latency->mark_count < CIRCULAR_BUFFER_LATENCY_MARKS)
+    {
+        size_t newest = (latency->mark_first + latency->mark_count - 1) % CIRCULAR_BUFFER_LATENCY_MARKS;
+
+        if (latency->mark_count == 0 || latency->push_seq - latency->marks[newest].seq >= latency->batch_size)
+        {
+            size_t slot = (latency->mark_first + latency->mark_count) % CIRCULAR_BUFFER_LATENCY_MARKS;
+            latency->marks[slot].seq = latency->push_seq;
+            latency->marks[slot].time = latency->clock(latency->clock_arg);
+            latency->mark_count++;
+        }
+    }
+
+    latency->push_seq += len;
+}
+
+void circular_buffer_latency_on_remove(circular_buffer_ctx *ctx, size_t len)
+{
+    circular_buffer_latency *latency = &ctx->latency;
+    bool have_now = false;
+    uint64_t now = 0;
+
+    latency->remove_seq += len;
+
+    // A batch ends where the next one starts, the newest one at the last byte pushed.
+    while (latency->mark_count > 0)
+    {
+        size_t next = (latency->mark_first + 1) % CIRCULAR_BUFFER_LATENCY_MARKS;
+        uint64_t end = (latency->mark_count > 1) ? latency->marks[next].seq : latency->push_seq;
+
+        if (latency->remove_seq < end)
+        {
+            break;
+        }
+
+        if (!have_now)
+        {
+            now = latency->clock(latency->clock_arg);
+            have_now = true;
+        }
+
+        latency_record(&latency->histogram, now - latency->marks[latency->mark_first].time);
+        latency->mark_first = next;
+        latency->mark_count--;
+    }
+}
+#endif
+
+bool circular_buffer_set_latency_clock(circular_buffer_ctx *ctx, circular_buffer_clock_fn clock, void *arg, size_t batch_size)
+{
+    bool res = false;
+
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+    // batch_size only matters while a clock is set.
+    if (circular_buffer_ctx_is_valid(ctx) && (!clock || batch_size > 0))
+    {
+        ctx->latency.clock = clock;
+        ctx->latency.clock_arg = arg;
+        ctx->latency.batch_size = batch_size;
+        // Batches timed with the previous clock cannot be compared with the new one.
+        ctx->latency.mark_first = 0;
+        ctx->latency.mark_count = 0;
+        res = true;
+    }
+#else
+    (void)ctx;
+    (void)clock;
+    (void)arg;
+    (void)batch_size;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_get_latency(const circular_buffer_ctx *ctx, circular_buffer_latency_histogram *histogram)
+{
+    bool res = false;
+
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+    if (histogram && circular_buffer_ctx_is_valid(ctx))
+    {
+        *histogram = ctx->latency.histogram;
+        res = true;
+    }
+#else
+    (void)ctx;
+    (void)histogram;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_get_and_clear_latency(circular_buffer_ctx *ctx, circular_buffer_latency_histogram *histogram)
+{
+    bool res = false;
+
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+    if (histogram && circular_buffer_ctx_is_valid(ctx))
+    {
+        *histogram = ctx->latency.histogram;
+        memset(&ctx->latency.histogram, 0, sizeof(ctx->latency.histogram));
+        res = true;
+    }
+#else
+    (void)ctx;
+    (void)histogram;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_set_watermarks(circular_buffer_ctx *ctx, size_t low, size_t high,
+                                    circular_buffer_watermark_cb cb, void *arg)
+{
+    bool res = false;
+
+    if (circular_buffer_ctx_is_valid(ctx) && !cb)
+    {
+        // Removing the watermarks, so the thresholds do not matter.
+        ctx->high_watermark = 0;
+        ctx->low_watermark = 0;
+        ctx->watermark_cb = NULL;
+        ctx->watermark_arg = NULL;
+        ctx->above_high = false;
+        res = true;
+    }
+    else if (circular_buffer_ctx_is_valid(ctx) && low < high && high <= ctx->buff_size)
+    {
+        ctx->high_watermark = high;
+        ctx->low_watermark = low;
+        ctx->watermark_cb = cb;
+        ctx->watermark_arg = arg;
+        // Start in the state matching the current fill level, so nothing fires until a crossing.
+        ctx->above_high = (ctx->current_byte_count >= high);
+        res = true;
+    }
+
+    return res;
+}
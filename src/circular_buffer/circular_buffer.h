@@ -14,17 +14,113 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+// Size of the storage embedded in every ctx for circular_buffer_init().
+// Define as 0 to drop the embedded storage and only use caller-provided storage,
+// which is not limited by this value.
 #ifndef CIRCULAR_BUFFER_MAX_SIZE
 #define CIRCULAR_BUFFER_MAX_SIZE 1024
 #endif
 
+// Build with CIRCULAR_BUFFER_INLINE_HOT_PATH defined (the CIRCULAR_BUFFER_INLINE_HOT_PATH
+// CMake option) to make the hot operations below static inline, so callers skip the call
+// into circular_buffer.c. Unchecked variants are always available inline; see circular_buffer_inline.h.
+#ifdef CIRCULAR_BUFFER_INLINE_HOT_PATH
+#define CIRCULAR_BUFFER_HOT_API static inline
+#else
+#define CIRCULAR_BUFFER_HOT_API
+#endif
+
+// Build with CIRCULAR_BUFFER_ENABLE_STATS defined (the CIRCULAR_BUFFER_ENABLE_STATS CMake option)
+// to keep a circular_buffer_stats block in every ctx. Without it the counters compile to nothing
+// and circular_buffer_get_stats() always fails.
+typedef struct {
+    uint64_t bytes_pushed;       // Accepted by push, write and commit
+    uint64_t bytes_popped;       // Removed by pop, read, consume, skip and clear
+    uint64_t bytes_overwritten;  // Dropped to make room, 64-bit counterpart of overflow_count
+    uint64_t rejected_pushes;    // push_no_overwrite and write calls refused for lack of space
+    uint64_t empty_pops;         // pop and read calls made on an empty buffer
+    size_t high_water;           // Highest byte count reached
+} circular_buffer_stats;
+
+// Build with CIRCULAR_BUFFER_ENABLE_LATENCY defined (the CIRCULAR_BUFFER_ENABLE_LATENCY CMake option)
+// to record how long bytes stay in the buffer. Pushes are timestamped per batch of bytes with a
+// caller-supplied clock, and each batch adds one sample to a log2 histogram once all of its bytes
+// have been removed. Without it nothing is recorded and the latency functions always fail.
+#ifndef CIRCULAR_BUFFER_LATENCY_MARKS
+#define CIRCULAR_BUFFER_LATENCY_MARKS 8   // Batches in flight that can be timed at once
+#endif
+#define CIRCULAR_BUFFER_LATENCY_BUCKETS 32
+
+/**
+ * @brief Reads a monotonic clock, in any unit (e.g. ns, us or cycle counter ticks).
+ *
+ * @param arg The user argument given to circular_buffer_set_latency_clock().
+ * @return The current time.
+ */
+typedef uint64_t (*circular_buffer_clock_fn)(void *arg);
+
+typedef struct {
+    // buckets[0] counts residencies of 0 ticks, buckets[k] those in [2^(k-1), 2^k).
+    // The last bucket also holds everything longer.
+    uint32_t buckets[CIRCULAR_BUFFER_LATENCY_BUCKETS];
+    uint64_t samples;
+    uint64_t max;                // Longest residency seen, in ticks
+} circular_buffer_latency_histogram;
+
+typedef struct {
+    uint64_t seq;                // Push sequence number of the first byte in the batch
+    uint64_t time;               // Clock reading when the batch was started
+} circular_buffer_latency_mark;
+
 typedef struct {
-    size_t buff_size;          // User can set up to MAX_SIZE
-    uint8_t buffer[CIRCULAR_BUFFER_MAX_SIZE];
+    circular_buffer_clock_fn clock;  // NULL until set, nothing is recorded without it
+    void *clock_arg;
+    size_t batch_size;           // Bytes covered by one timestamp
+    uint64_t push_seq;           // Bytes ever added
+    uint64_t remove_seq;         // Bytes ever removed, including overwritten and cleared bytes
+    circular_buffer_latency_mark marks[CIRCULAR_BUFFER_LATENCY_MARKS];  // FIFO, oldest batch first
+    size_t mark_first;
+    size_t mark_count;
+    circular_buffer_latency_histogram histogram;
+} circular_buffer_latency;
+
+typedef enum {
+    CIRCULAR_BUFFER_WATERMARK_HIGH,  // Fill level rose to the high watermark
+    CIRCULAR_BUFFER_WATERMARK_LOW,   // Fill level fell back to the low watermark
+} circular_buffer_watermark_event;
+
+/**
+ * @brief Called from inside the buffer operation that crossed a watermark.
+ * Runs in the caller's context (e.g. the ISR that pushed), so keep it short,
+ * e.g. set a flag or signal a task. Must not call back into the same buffer.
+ *
+ * @param event Which watermark was crossed.
+ * @param byte_count The number of bytes stored after the operation.
+ * @param arg The user argument given to circular_buffer_set_watermarks().
+ */
+typedef void (*circular_buffer_watermark_cb)(circular_buffer_watermark_event event, size_t byte_count, void *arg);
+
+typedef struct {
+    size_t buff_size;          // Up to MAX_SIZE with embedded storage, any size with caller storage
+    uint8_t *buffer;           // Points at the embedded storage or the caller's memory
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    uint8_t storage[CIRCULAR_BUFFER_MAX_SIZE];
+#endif
     size_t head;               // Handles any reasonable buffer size
     size_t tail;
     size_t current_byte_count;
     uint32_t overflow_count;   // Accumulates over time
+    size_t high_watermark;
+    size_t low_watermark;
+    circular_buffer_watermark_cb watermark_cb;  // NULL when no watermarks are set
+    void *watermark_arg;
+    bool above_high;           // Set once HIGH fired, cleared once LOW fired
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+    circular_buffer_stats stats;
+#endif
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+    circular_buffer_latency latency;
+#endif
 } circular_buffer_ctx;
 
 /**
@@ -32,10 +128,25 @@ typedef struct {
  *
  * @param ctx A blank handle for the buffer.
  * @param buff_size The size of the buffer to instantiate. Must be less than or equal to MAX_BUFFER_SIZE.
- * @return true if success, false if init failure.
+ * @return true if success, false if init failure. Always fails if CIRCULAR_BUFFER_MAX_SIZE is 0.
 */
 bool circular_buffer_init(circular_buffer_ctx *ctx, size_t buff_size);
 
+/**
+ * @brief Initializes an instance of circular buffer over caller-provided storage,
+ * e.g. a static array, a pool block or an mmap'd region. The size is not limited
+ * by CIRCULAR_BUFFER_MAX_SIZE.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param mem The storage to use. Must stay valid, and not be used for anything else, for the life of the buffer.
+ * @param len The size of mem in bytes, which becomes the size of the buffer.
+ * @return true if success, false if init failure.
+ *
+ * @note The ctx refers to its storage by pointer, so a ctx must not be copied
+ * to make a second buffer. Initialize a new one instead.
+*/
+bool circular_buffer_init_with_storage(circular_buffer_ctx *ctx, uint8_t *mem, size_t len);
+
 /**
  * @brief Adds an item to the circular buffer.
  * Will overwrite the oldest data in buffer if full on push.
@@ -45,7 +156,7 @@ bool circular_buffer_init(circular_buffer_ctx *ctx, size_t buff_size);
  *
  * @return true on success.
 */
-bool circular_buffer_push_with_overwrite(circular_buffer_ctx *ctx, uint8_t data);
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_push_with_overwrite(circular_buffer_ctx *ctx, uint8_t data);
 
 /**
  * @brief Adds an item to the circular buffer.
@@ -56,7 +167,7 @@ bool circular_buffer_push_with_overwrite(circular_buffer_ctx *ctx, uint8_t data)
  *
  * @return true on success.
 */
-bool circular_buffer_push_no_overwrite(circular_buffer_ctx *ctx, uint8_t data);
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_push_no_overwrite(circular_buffer_ctx *ctx, uint8_t data);
 
 /**
  * @brief Removes an item from the circular buffer.
@@ -66,7 +177,131 @@ bool circular_buffer_push_no_overwrite(circular_buffer_ctx *ctx, uint8_t data);
  *
  * @return true on success.
 */
-bool circular_buffer_pop(circular_buffer_ctx *ctx, uint8_t *data);
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_pop(circular_buffer_ctx *ctx, uint8_t *data);
+
+/**
+ * @brief Adds a block of data to the circular buffer.
+ * Equivalent to pushing each byte in order, but validates once and copies
+ * the block in at most two contiguous pieces.
+ *
+ * @param ctx A handle for the buffer.
+ * @param src The data to push.
+ * @param len The number of bytes to push.
+ * @param overwrite If true, the oldest data is overwritten to make room, as with
+ *                  circular_buffer_push_with_overwrite(). If false, nothing is
+ *                  written unless all len bytes fit.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_write(circular_buffer_ctx *ctx, const uint8_t *src, size_t len, bool overwrite);
+
+/**
+ * @brief Removes a block of data from the circular buffer.
+ * Equivalent to popping len bytes in order. Nothing is removed unless
+ * at least len bytes are in the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param dst A place to return the popped data. Must hold len bytes.
+ * @param len The number of bytes to pop.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_read(circular_buffer_ctx *ctx, uint8_t *dst, size_t len);
+
+/**
+ * @brief Reads one stored byte without removing anything, for lookahead parsing.
+ *
+ * @param ctx A handle for the buffer.
+ * @param offset The position of the byte, counted from the oldest byte. Offset 0 is what
+ *               circular_buffer_peek() returns.
+ * @param data A pointer to return the byte.
+ *
+ * @return true on success, false if fewer than offset + 1 bytes are stored or on invalid arguments.
+*/
+bool circular_buffer_peek_at(const circular_buffer_ctx *ctx, size_t offset, uint8_t *data);
+
+/**
+ * @brief Copies stored bytes out without removing anything, e.g. a header at a known offset.
+ * Copies in at most two pieces, like circular_buffer_read().
+ *
+ * @param ctx A handle for the buffer.
+ * @param offset The position of the first byte to copy, counted from the oldest byte.
+ * @param dst A place to return the data. Must hold len bytes.
+ * @param len The number of bytes to copy.
+ *
+ * @return true on success, false if fewer than offset + len bytes are stored or on invalid arguments.
+*/
+bool circular_buffer_peek_range(const circular_buffer_ctx *ctx, size_t offset, uint8_t *dst, size_t len);
+
+/**
+ * @brief Exposes the largest contiguous free region so a producer (e.g. DMA)
+ * can fill it in place. Nothing is added until circular_buffer_commit() is called.
+ *
+ * @param ctx A handle for the buffer.
+ * @param ptr A pointer to return the start of the free region.
+ * @param len A pointer to return the size of the free region in bytes.
+ *
+ * @return true on success, false if the buffer is full or on invalid arguments.
+ *
+ * @note If the buffer is empty, head and tail are moved back to the start of
+ * storage so the whole buffer is offered as one region.
+*/
+bool circular_buffer_reserve(circular_buffer_ctx *ctx, uint8_t **ptr, size_t *len);
+
+/**
+ * @brief Publishes bytes written in place after circular_buffer_reserve().
+ *
+ * @param ctx A handle for the buffer.
+ * @param len The number of bytes written. At most the reserved length, i.e. the contiguous
+ *            free region from head that circular_buffer_reserve() returns.
+ *
+ * @return true on success, false if len exceeds that region or on invalid arguments.
+*/
+bool circular_buffer_commit(circular_buffer_ctx *ctx, size_t len);
+
+/**
+ * @brief Exposes the largest contiguous run of stored data, oldest first, so a
+ * consumer can parse it in place. Nothing is removed until circular_buffer_consume() is called.
+ *
+ * @param ctx A handle for the buffer.
+ * @param ptr A pointer to return the start of the stored data.
+ * @param len A pointer to return the number of contiguous bytes available at ptr.
+ *            If the data wraps, the rest is returned by the next call after consuming.
+ *
+ * @return true on success, false if the buffer is empty or on invalid arguments.
+*/
+bool circular_buffer_peek_contiguous(const circular_buffer_ctx *ctx, const uint8_t **ptr, size_t *len);
+
+/**
+ * @brief Removes bytes after they have been processed in place.
+ *
+ * @param ctx A handle for the buffer.
+ * @param len The number of bytes to remove. Must not exceed the number of bytes stored.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_consume(circular_buffer_ctx *ctx, size_t len);
+
+/**
+ * @brief Drops the oldest bytes unread in constant time, e.g. a corrupt frame or an unwanted payload.
+ * An alias of circular_buffer_consume(), named for callers that never looked at the bytes.
+ *
+ * @param ctx A handle for the buffer.
+ * @param len The number of bytes to drop. Nothing is dropped unless at least len bytes are stored.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_skip(circular_buffer_ctx *ctx, size_t len);
+
+/**
+ * @brief Empties the buffer, e.g. to resynchronize after line noise.
+ * Unlike running init again, the overflow count and the watermarks are kept.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_clear(circular_buffer_ctx *ctx);
 
 /**
  * @brief Allows peeking at the next item without popping it.
@@ -76,7 +311,7 @@ bool circular_buffer_pop(circular_buffer_ctx *ctx, uint8_t *data);
  *
  * @return true on success.
  */
-bool circular_buffer_peek(const circular_buffer_ctx *ctx, uint8_t *data);
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_peek(const circular_buffer_ctx *ctx, uint8_t *data);
 
 /**
  * @brief Use to check if there is anything in the buffer.
@@ -86,7 +321,7 @@ bool circular_buffer_peek(const circular_buffer_ctx *ctx, uint8_t *data);
  * @return true if the buffer is empty or if the ctx is NULL, false if there
  *          are items in the buffer.
  */
-bool circular_buffer_is_empty(const circular_buffer_ctx *ctx);
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_is_empty(const circular_buffer_ctx *ctx);
 
 /**
  * @brief Use to check if the buffer is full.
@@ -95,7 +330,7 @@ bool circular_buffer_is_empty(const circular_buffer_ctx *ctx);
  *
  * @return true if the buffer is full and false if it is not full.
  */
-bool circular_buffer_is_full(const circular_buffer_ctx *ctx);
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_is_full(const circular_buffer_ctx *ctx);
 
 /**
  * @brief Use to retrieve the amount of free space in the buffer.
@@ -126,4 +361,97 @@ bool circular_buffer_get_overflow_count(const circular_buffer_ctx *ctx, uint32_t
  */
 bool circular_buffer_clear_overflow_count(circular_buffer_ctx *ctx);
 
+/**
+ * @brief Copies out the statistics kept since init or the last clear.
+ *
+ * @param ctx A handle for the buffer.
+ * @param stats A pointer to return the statistics.
+ *
+ * @return true on success, false on invalid arguments or if built without CIRCULAR_BUFFER_ENABLE_STATS.
+ */
+bool circular_buffer_get_stats(const circular_buffer_ctx *ctx, circular_buffer_stats *stats);
+
+/**
+ * @brief Copies out the statistics and restarts them in the same call, so no update falls
+ * between the two. The high water mark restarts from the current byte count.
+ * A plain copy and reset, not atomic: needs the same protection as any other call on the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param stats A pointer to return the statistics.
+ *
+ * @return true on success, false on invalid arguments or if built without CIRCULAR_BUFFER_ENABLE_STATS.
+ */
+bool circular_buffer_get_and_clear_stats(circular_buffer_ctx *ctx, circular_buffer_stats *stats);
+
+/**
+ * @brief Starts timing how long bytes stay in the buffer.
+ *
+ * The clock is read when a push starts a new batch, i.e. when it lands batch_size or more bytes
+ * after the start of the current batch, or when no batch is being timed, and again when a
+ * removal finishes off one or more batches. A batch's residency runs from its first push to the
+ * removal of its last byte. If CIRCULAR_BUFFER_LATENCY_MARKS batches are already in flight, new
+ * bytes join the newest batch, which makes its sample longer rather than losing it.
+ * Bytes stored before the clock was set are not timed.
+ *
+ * @param ctx A handle for the buffer.
+ * @param clock The clock to read, or NULL to stop timing.
+ * @param arg Passed to clock unchanged.
+ * @param batch_size The number of bytes covered by one timestamp. At least 1. Larger batches
+ *                   read the clock less often at the cost of coarser samples. Ignored if clock is NULL.
+ *
+ * @return true on success, false on invalid arguments or if built without CIRCULAR_BUFFER_ENABLE_LATENCY.
+ */
+bool circular_buffer_set_latency_clock(circular_buffer_ctx *ctx, circular_buffer_clock_fn clock, void *arg, size_t batch_size);
+
+/**
+ * @brief Copies out the residency histogram recorded since the clock was set or the last clear.
+ *
+ * @param ctx A handle for the buffer.
+ * @param histogram A pointer to return the histogram.
+ *
+ * @return true on success, false on invalid arguments or if built without CIRCULAR_BUFFER_ENABLE_LATENCY.
+ */
+bool circular_buffer_get_latency(const circular_buffer_ctx *ctx, circular_buffer_latency_histogram *histogram);
+
+/**
+ * @brief Copies out the residency histogram and empties it in the same call.
+ * Batches still in the buffer keep being timed.
+ *
+ * @param ctx A handle for the buffer.
+ * @param histogram A pointer to return the histogram.
+ *
+ * @return true on success, false on invalid arguments or if built without CIRCULAR_BUFFER_ENABLE_LATENCY.
+ */
+bool circular_buffer_get_and_clear_latency(circular_buffer_ctx *ctx, circular_buffer_latency_histogram *histogram);
+
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+// Called by every operation that adds or removes bytes. Not for use outside the library.
+void circular_buffer_latency_on_push(circular_buffer_ctx *ctx, size_t len);
+void circular_buffer_latency_on_remove(circular_buffer_ctx *ctx, size_t len);
+#endif
+
+/**
+ * @brief Registers a callback that fires when the fill level crosses a watermark, so a
+ * consumer can be signaled once per batch instead of polling, and a producer can throttle
+ * once when the buffer is nearly full.
+ *
+ * HIGH fires once when the byte count rises to high or above. LOW fires once when it then
+ * falls to low or below, which re-arms HIGH. Each event fires at most once per crossing no
+ * matter how many bytes the operation moved. Only later operations fire events, so if the
+ * buffer is already at or above high when registering, the next event is LOW.
+ *
+ * @param ctx A handle for the buffer.
+ * @param low The low watermark in bytes. Must be less than high. Ignored if cb is NULL.
+ * @param high The high watermark in bytes. Must be between 1 and the buffer size.
+ *             Ignored if cb is NULL.
+ * @param cb The callback, or NULL to remove the watermarks.
+ * @param arg Passed to cb unchanged.
+ *
+ * @return true on success, false on invalid arguments.
+ */
+bool circular_buffer_set_watermarks(circular_buffer_ctx *ctx, size_t low, size_t high,
+                                    circular_buffer_watermark_cb cb, void *arg);
+
+#include "circular_buffer_inline.h"
+
 #endif /* _CIRCULAR_BUFFER_H */
@@ -0,0 +1,196 @@
+/**
+ * @file circular_buffer.hpp
+ * @brief A header-only C++ counterpart of circular_buffer.h with the element type and
+ * capacity fixed at compile time.
+ *
+ * Since N is a constant, index wrapping folds to a mask for power-of-two sizes and to a
+ * compare otherwise, and everything inlines into the caller. No heap allocation is made,
+ * all operations are constexpr (C++14), and move-only element types are supported.
+ *
+ * T must be default-constructible and move-assignable. Popped slots are reset to T() so
+ * resources held by an element are released as soon as it leaves the buffer.
+ *
+ * @note Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_HPP
+#define _CIRCULAR_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+template <typename T, std::size_t N>
+class CircularBuffer {
+    static_assert(N > 0, "CircularBuffer capacity must be greater than zero");
+
+    template <bool IsConst>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const T *, T *>::type;
+        using reference = typename std::conditional<IsConst, const T &, T &>::type;
+        using owner_type = typename std::conditional<IsConst, const CircularBuffer, CircularBuffer>::type;
+
+        constexpr basic_iterator() = default;
+        constexpr basic_iterator(owner_type *owner, std::size_t offset) : owner_(owner), offset_(offset) {}
+
+        constexpr reference operator*() const { return owner_->buffer_[owner_->position(offset_)]; }
+        constexpr pointer operator->() const { return &**this; }
+
+        constexpr basic_iterator &operator++()
+        {
+            offset_++;
+            return *this;
+        }
+
+        constexpr basic_iterator operator++(int)
+        {
+            basic_iterator previous = *this;
+            offset_++;
+            return previous;
+        }
+
+        constexpr bool operator==(const basic_iterator &other) const
+        {
+            return owner_ == other.owner_ && offset_ == other.offset_;
+        }
+
+        constexpr bool operator!=(const basic_iterator &other) const { return !(*this == other); }
+
+    private:
+        owner_type *owner_ = nullptr;
+        std::size_t offset_ = 0;   // Distance from the oldest element
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    constexpr CircularBuffer() = default;
+
+    /**
+     * @brief Adds an item to the buffer.
+     * Will overwrite the oldest item in buffer if full on push.
+     *
+     * @return true on success.
+     */
+    constexpr bool push_with_overwrite(const T &value) { return push(value, true); }
+    constexpr bool push_with_overwrite(T &&value) { return push(std::move(value), true); }
+
+    /**
+     * @brief Adds an item to the buffer.
+     * Never overwrites data in buffer. Fails if buffer is full, in which case
+     * an rvalue argument is left untouched.
+     *
+     * @return true on success.
+     */
+    constexpr bool push_no_overwrite(const T &value) { return push(value, false); }
+    constexpr bool push_no_overwrite(T &&value) { return push(std::move(value), false); }
+
+    /**
+     * @brief Removes the oldest item from the buffer.
+     *
+     * @param out A place to move the popped item into.
+     *
+     * @return true on success, false if the buffer is empty.
+     */
+    constexpr bool pop(T &out)
+    {
+        bool res = false;
+
+        if (count_ > 0)
+        {
+            out = std::move(buffer_[tail_]);
+            buffer_[tail_] = T();
+            tail_ = next(tail_);
+            count_--;
+            res = true;
+        }
+
+        return res;
+    }
+
+    /**
+     * @brief Allows peeking at the oldest item without popping it.
+     *
+     * @return A pointer to the oldest item, or nullptr if the buffer is empty.
+     */
+    constexpr const T *peek() const { return (count_ > 0) ? &buffer_[tail_] : nullptr; }
+
+    constexpr bool is_empty() const { return count_ == 0; }
+    constexpr bool is_full() const { return count_ == N; }
+
+    /** @brief The number of items stored. */
+    constexpr size_type size() const { return count_; }
+
+    /** @brief The total number of items the buffer can hold. */
+    static constexpr size_type capacity() { return N; }
+
+    /** @brief The current free capacity in items. */
+    constexpr size_type current_capacity() const { return N - count_; }
+
+    /** @brief The number of items that have been overwritten due to overflow. */
+    constexpr std::uint32_t overflow_count() const { return overflow_count_; }
+    constexpr void clear_overflow_count() { overflow_count_ = 0; }
+
+    /** @brief Iterates from the oldest item to the newest. */
+    constexpr iterator begin() { return iterator(this, 0); }
+    constexpr iterator end() { return iterator(this, count_); }
+    constexpr const_iterator begin() const { return const_iterator(this, 0); }
+    constexpr const_iterator end() const { return const_iterator(this, count_); }
+    constexpr const_iterator cbegin() const { return begin(); }
+    constexpr const_iterator cend() const { return end(); }
+
+private:
+    static constexpr bool kIsPowerOfTwo = (N & (N - 1)) == 0;
+
+    // N is a constant, so the unused branch folds away.
+    static constexpr size_type next(size_type index)
+    {
+        return kIsPowerOfTwo ? ((index + 1) & (N - 1)) : ((index + 1 == N) ? 0 : index + 1);
+    }
+
+    // Storage index of the element offset places after the oldest.
+    constexpr size_type position(size_type offset) const
+    {
+        return kIsPowerOfTwo ? ((tail_ + offset) & (N - 1)) : ((tail_ + offset) % N);
+    }
+
+    template <typename U>
+    constexpr bool push(U &&value, bool overwrite)
+    {
+        bool res = false;
+
+        if (count_ < N || overwrite)
+        {
+            // Buffer is full if true, overwrite mode.
+            if (count_ == N)
+            {
+                tail_ = next(tail_);
+                count_--;
+                overflow_count_++;
+            }
+
+            buffer_[head_] = std::forward<U>(value);
+            head_ = next(head_);
+            count_++;
+            res = true;
+        }
+
+        return res;
+    }
+
+    T buffer_[N]{};
+    size_type head_ = 0;
+    size_type tail_ = 0;
+    size_type count_ = 0;
+    std::uint32_t overflow_count_ = 0;   // Accumulates over time
+};
+
+#endif /* _CIRCULAR_BUFFER_HPP */
@@ -0,0 +1,39 @@
+/**
+ * @file circular_buffer_atomic.h
+ * @brief Declares the atomic fields shared by the lock-free buffer variants.
+ *
+ * The implementations are C11 and access these fields through <stdatomic.h>.
+ * C++ code that includes the headers (e.g. the unit tests) only needs the layout
+ * to allocate a ctx, so there the fields are declared as the plain underlying type,
+ * which has the same size and alignment on the supported compilers.
+ *
+ * CIRCULAR_BUFFER_CACHE_LINE_SIZE selects the layout of the fields that are written
+ * from different cores. Left at 0 the ctx stays compact. Set to the target's cache line
+ * size (e.g. 64) to give the producer-owned and consumer-owned fields a line each, so a
+ * push on one core does not invalidate the line the consumer is polling on another.
+ */
+#ifndef _CIRCULAR_BUFFER_ATOMIC_H
+#define _CIRCULAR_BUFFER_ATOMIC_H
+
+#ifdef __cplusplus
+#define CIRCULAR_BUFFER_ATOMIC(type) type
+#else
+#include <stdatomic.h>
+#define CIRCULAR_BUFFER_ATOMIC(type) _Atomic type
+#endif
+
+#ifndef CIRCULAR_BUFFER_CACHE_LINE_SIZE
+#define CIRCULAR_BUFFER_CACHE_LINE_SIZE 0
+#endif
+
+#if CIRCULAR_BUFFER_CACHE_LINE_SIZE > 0
+#ifdef __cplusplus
+#define CIRCULAR_BUFFER_CACHE_ALIGNED alignas(CIRCULAR_BUFFER_CACHE_LINE_SIZE)
+#else
+#define CIRCULAR_BUFFER_CACHE_ALIGNED _Alignas(CIRCULAR_BUFFER_CACHE_LINE_SIZE)
+#endif
+#else
+#define CIRCULAR_BUFFER_CACHE_ALIGNED
+#endif
+
+#endif /* _CIRCULAR_BUFFER_ATOMIC_H */
@@ -0,0 +1,139 @@
+#include <errno.h>
+#include <sys/uio.h>
+
+#include "circular_buffer_fd.h"
+
+// Describes the free space, from head up to tail, as at most two segments.
+static int free_segments(const circular_buffer_ctx *ctx, struct iovec iov[2])
+{
+    int count = 0;
+    size_t free_space = ctx->buff_size - ctx->current_byte_count;
+
+    if (free_space > 0)
+    {
+        size_t first_len = ctx->buff_size - ctx->head;
+
+        if (first_len > free_space)
+        {
+            first_len = free_space;
+        }
+
+        iov[0].iov_base = &ctx->buffer[ctx->head];
+        iov[0].iov_len = first_len;
+        iov[1].iov_base = &ctx->buffer[0];
+        iov[1].iov_len = free_space - first_len;
+        count = (iov[1].iov_len > 0) ? 2 : 1;
+    }
+
+    return count;
+}
+
+// Describes the stored data, from tail up to head, as at most two segments.
+static int data_segments(const circular_buffer_ctx *ctx, struct iovec iov[2])
+{
+    int count = 0;
+
+    if (ctx->current_byte_count > 0)
+    {
+        size_t first_len = ctx->buff_size - ctx->tail;
+
+        if (first_len > ctx->current_byte_count)
+        {
+            first_len = ctx->current_byte_count;
+        }
+
+        iov[0].iov_base = &ctx->buffer[ctx->tail];
+        iov[0].iov_len = first_len;
+        iov[1].iov_base = &ctx->buffer[0];
+        iov[1].iov_len = ctx->current_byte_count - first_len;
+        count = (iov[1].iov_len > 0) ? 2 : 1;
+    }
+
+    return count;
+}
+
+bool circular_buffer_fill_from_fd(circular_buffer_ctx *ctx, int fd, size_t *bytes_read)
+{
+    bool res = false;
+
+    if (bytes_read && circular_buffer_ctx_is_valid(ctx))
+    {
+        struct iovec iov[2];
+        int iov_count = free_segments(ctx, iov);
+
+        *bytes_read = 0;
+
+        if (iov_count == 0)
+        {
+            errno = ENOBUFS;
+        }
+        else
+        {
+            ssize_t n;
+
+            do
+            {
+                n = readv(fd, iov, iov_count);
+            } while (n < 0 && errno == EINTR);
+
+            if (n >= 0)
+            {
+                // A commit stops at the end of storage, so the second segment is committed on its own.
+                // The commit fires any watermark the new data crossed.
+                size_t first_len = ((size_t)n < iov[0].iov_len) ? (size_t)n : iov[0].iov_len;
+
+                if (circular_buffer_commit(ctx, first_len) &&
+                    (first_len == (size_t)n || circular_buffer_commit(ctx, (size_t)n - first_len)))
+                {
+                    *bytes_read = (size_t)n;
+                    res = true;
+                }
+            }
+        }
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+    return res;
+}
+
+bool circular_buffer_drain_to_fd(circular_buffer_ctx *ctx, int fd, size_t *bytes_written)
+{
+    bool res = false;
+
+    if (bytes_written && circular_buffer_ctx_is_valid(ctx))
+    {
+        struct iovec iov[2];
+        int iov_count = data_segments(ctx, iov);
+
+        *bytes_written = 0;
+
+        if (iov_count == 0)
+        {
+            res = true;
+        }
+        else
+        {
+            ssize_t n;
+
+            do
+            {
+                n = writev(fd, iov, iov_count);
+            } while (n < 0 && errno == EINTR);
+
+            if (n >= 0 && circular_buffer_consume(ctx, (size_t)n))
+            {
+                *bytes_written = (size_t)n;
+                res = true;
+            }
+        }
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+    return res;
+}
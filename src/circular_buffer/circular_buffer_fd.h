@@ -0,0 +1,51 @@
+/**
+ * @file circular_buffer_fd.h
+ * @brief Moves data between a circular_buffer_ctx and a file descriptor (socket, pipe, tty, file)
+ * without an intermediate copy.
+ *
+ * The free space (for a fill) or the stored data (for a drain) is at most two contiguous segments
+ * of the storage. Both are passed to readv()/writev() as iovecs, so a single system call moves as
+ * much as the buffer and the fd allow. Short transfers just move fewer bytes, and the buffer is
+ * updated by exactly the number of bytes transferred.
+ *
+ * @note Built when CIRCULAR_BUFFER_LINUX_EXTENSIONS is on. Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_FD_H
+#define _CIRCULAR_BUFFER_FD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+/**
+ * @brief Reads from fd straight into the free space of the buffer with one readv().
+ * Retries if interrupted by a signal.
+ *
+ * @param ctx A handle for the buffer.
+ * @param fd The file descriptor to read from.
+ * @param bytes_read A pointer to return the number of bytes added to the buffer.
+ *                   0 with a true return means end of file.
+ *
+ * @return true on success or end of file. false with errno set otherwise: ENOBUFS if the buffer
+ *         is full, EAGAIN/EWOULDBLOCK if a non-blocking fd has no data, EINVAL on invalid
+ *         arguments, or the error from readv().
+ */
+bool circular_buffer_fill_from_fd(circular_buffer_ctx *ctx, int fd, size_t *bytes_read);
+
+/**
+ * @brief Writes stored data, oldest first, straight from the buffer to fd with one writev().
+ * Only the bytes the fd accepted are removed. Retries if interrupted by a signal.
+ *
+ * @param ctx A handle for the buffer.
+ * @param fd The file descriptor to write to.
+ * @param bytes_written A pointer to return the number of bytes removed from the buffer.
+ *                      0 with a true return means the buffer was empty.
+ *
+ * @return true on success. false with errno set otherwise: EAGAIN/EWOULDBLOCK if a non-blocking
+ *         fd cannot take more data, EINVAL on invalid arguments, or the error from writev().
+ */
+bool circular_buffer_drain_to_fd(circular_buffer_ctx *ctx, int fd, size_t *bytes_written);
+
+#endif /* _CIRCULAR_BUFFER_FD_H */
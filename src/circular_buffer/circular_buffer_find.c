@@ -0,0 +1,166 @@
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "circular_buffer_find.h"
+
+// Returns the index of the first byte equal to byte in data[0, len), or len if there is none.
+// Full vectors are compared with SIMD where the target supports it, the rest with memchr().
+static size_t scan_byte(const uint8_t *data, size_t len, uint8_t byte)
+{
+    size_t i = 0;
+    const uint8_t *hit = NULL;
+
+#if defined(__AVX2__)
+    const __m256i needle_256 = _mm256_set1_epi8((char)byte);
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(const void *)&data[i]);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle_256));
+        if (mask)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    // With AVX2 this only sees the last partial 32-byte block.
+    const __m128i needle_128 = _mm_set1_epi8((char)byte);
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(const void *)&data[i]);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle_128));
+        if (mask)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t needle_128 = vdupq_n_u8(byte);
+    for (; i + 16 <= len; i += 16)
+    {
+        uint8x16_t equal = vceqq_u8(vld1q_u8(&data[i]), needle_128);
+        // NEON has no movemask. Narrowing shift packs each lane's result into 4 bits of a 64-bit mask.
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+        if (mask)
+        {
+            return i + ((size_t)__builtin_ctzll(mask) >> 2);
+        }
+    }
+#endif
+
+    if (i < len)
+    {
+        hit = memchr(&data[i], byte, len - i);
+    }
+
+    return hit ? (size_t)(hit - data) : len;
+}
+
+// Number of stored bytes in the first run, from tail towards the end of storage.
+static size_t first_run_len(const circular_buffer_ctx *ctx)
+{
+    size_t len = ctx->buff_size - ctx->tail;
+    return (ctx->current_byte_count < len) ? ctx->current_byte_count : len;
+}
+
+// Looks for byte at offsets [start, end) from the oldest byte. end must not exceed the byte count.
+static bool find_in_range(const circular_buffer_ctx *ctx, uint8_t byte, size_t start, size_t end, size_t *offset)
+{
+    bool res = false;
+    size_t first_len = first_run_len(ctx);
+
+    if (start < first_len)
+    {
+        size_t run_end = (end < first_len) ? end : first_len;
+        size_t index = scan_byte(&ctx->buffer[ctx->tail + start], run_end - start, byte);
+
+        if (index < run_end - start)
+        {
+            *offset = start + index;
+            res = true;
+        }
+        start = first_len;
+    }
+
+    // The second run starts at the beginning of storage, at offset first_len.
+    if (!res && start < end)
+    {
+        size_t index = scan_byte(&ctx->buffer[start - first_len], end - start, byte);
+
+        if (index < end - start)
+        {
+            *offset = start + index;
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+// Compares the stored bytes at offset with pattern. offset + len must not exceed the byte count.
+static bool matches_at(const circular_buffer_ctx *ctx, size_t offset, const uint8_t *pattern, size_t len)
+{
+    size_t position = ctx->tail + offset;
+    size_t first_len;
+
+    if (position >= ctx->buff_size)
+    {
+        position -= ctx->buff_size;
+    }
+
+    first_len = ctx->buff_size - position;
+    if (first_len > len)
+    {
+        first_len = len;
+    }
+
+    return memcmp(&ctx->buffer[position], pattern, first_len) == 0 &&
+           memcmp(&ctx->buffer[0], pattern + first_len, len - first_len) == 0;
+}
+
+bool circular_buffer_find(const circular_buffer_ctx *ctx, uint8_t byte, size_t *offset)
+{
+    bool res = false;
+
+    if (offset && circular_buffer_ctx_is_valid(ctx))
+    {
+        res = find_in_range(ctx, byte, 0, ctx->current_byte_count, offset);
+    }
+
+    return res;
+}
+
+bool circular_buffer_find_pattern(const circular_buffer_ctx *ctx, const uint8_t *pattern, size_t pattern_len, size_t *offset)
+{
+    bool res = false;
+
+    if (offset && pattern && 0 < pattern_len && circular_buffer_ctx_is_valid(ctx) &&
+        pattern_len <= ctx->current_byte_count)
+    {
+        // A match can only start where there is room for the whole pattern.
+        size_t end = ctx->current_byte_count - pattern_len + 1;
+        size_t start = 0;
+        size_t candidate = 0;
+
+        // Vector scan for the first pattern byte, then verify the rest.
+        while (!res && find_in_range(ctx, pattern[0], start, end, &candidate))
+        {
+            if (matches_at(ctx, candidate, pattern, pattern_len))
+            {
+                *offset = candidate;
+                res = true;
+            }
+            start = candidate + 1;
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file circular_buffer_find.h
+ * @brief Searches the stored data of a circular_buffer_ctx without removing anything, so a
+ * consumer can learn the length of a line or frame and then take it with one circular_buffer_read().
+ *
+ * The stored data is scanned as two runs, tail to the end of storage and then the start of
+ * storage up to head. Each run is scanned 32 bytes at a time with AVX2, or 16 at a time with
+ * SSE2 or NEON, whichever the compiler targets (e.g. -mavx2 or -march=native), with memchr()
+ * as the fallback.
+ *
+ * @note Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_FIND_H
+#define _CIRCULAR_BUFFER_FIND_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+/**
+ * @brief Finds the first occurrence of a byte in the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param byte The byte to look for, e.g. '\n' or a sync byte.
+ * @param offset A pointer to return the position of the match, counted from the oldest byte.
+ *               offset + 1 bytes must be read to include the match.
+ *
+ * @return true if found, false if not found or on invalid arguments.
+ */
+bool circular_buffer_find(const circular_buffer_ctx *ctx, uint8_t byte, size_t *offset);
+
+/**
+ * @brief Finds the first occurrence of a byte sequence in the buffer. A match may span the
+ * wrap point of the storage.
+ *
+ * @param ctx A handle for the buffer.
+ * @param pattern The bytes to look for, e.g. "\r\n" or a multi-byte sync word.
+ * @param pattern_len The length of pattern. Must be at least 1.
+ * @param offset A pointer to return the position of the first byte of the match, counted from the oldest byte.
+ *
+ * @return true if found, false if not found or on invalid arguments.
+ */
+bool circular_buffer_find_pattern(const circular_buffer_ctx *ctx, const uint8_t *pattern, size_t pattern_len, size_t *offset);
+
+#endif /* _CIRCULAR_BUFFER_FIND_H */
@@ -0,0 +1,174 @@
+#include <string.h>
+
+#include "circular_buffer_frame.h"
+
+// Returns the number of bytes stored, and doubles as the validity check on ctx.
+static bool get_byte_count(const circular_buffer_ctx *ctx, size_t *count)
+{
+    size_t capacity = 0;
+    bool res = circular_buffer_get_current_capacity(ctx, &capacity);
+
+    if (res)
+    {
+        *count = ctx->buff_size - capacity;
+    }
+
+    return res;
+}
+
+static size_t encode_header(size_t len, uint8_t *header)
+{
+    size_t header_len = 0;
+
+    do
+    {
+        uint8_t byte = (uint8_t)(len & 0x7F);
+        len >>= 7;
+        header[header_len++] = (len > 0) ? (uint8_t)(byte | 0x80) : byte;
+    } while (len > 0);
+
+    return header_len;
+}
+
+// Copies len bytes in, offset bytes after head, splitting the copy at the end of storage.
+// Caller guarantees that offset + len fits in the free space. Publishes nothing.
+static void copy_in_at(circular_buffer_ctx *ctx, size_t offset, const uint8_t *src, size_t len)
+{
+    size_t start = (ctx->head + offset) % ctx->buff_size;
+    size_t first_len = ctx->buff_size - start;
+
+    if (first_len > len)
+    {
+        first_len = len;
+    }
+
+    memcpy(&ctx->buffer[start], src, first_len);
+    memcpy(&ctx->buffer[0], src + first_len, len - first_len);
+}
+
+// Decodes the header of the oldest message. Defensive like ctx_is_valid: fails on a
+// malformed header or one that claims more bytes than are stored.
+static bool decode_header(const circular_buffer_ctx *ctx, size_t *header_len, size_t *msg_len)
+{
+    bool res = false;
+    size_t count = 0;
+
+    if (get_byte_count(ctx, &count))
+    {
+        size_t len = 0;
+
+        uint8_t byte = 0;
+
+        for (size_t i = 0; i < CIRCULAR_BUFFER_FRAME_MAX_HEADER_SIZE && circular_buffer_peek_at(ctx, i, &byte); i++)
+        {
+            len |= (size_t)(byte & 0x7F) << (7 * i);
+
+            if ((byte & 0x80) == 0)
+            {
+                if (len <= count - (i + 1))
+                {
+                    *header_len = i + 1;
+                    *msg_len = len;
+                    res = true;
+                }
+                break;
+            }
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_frame_push(circular_buffer_ctx *ctx, const uint8_t *msg, size_t len, bool overwrite)
+{
+    bool res = false;
+    uint8_t header[CIRCULAR_BUFFER_FRAME_MAX_HEADER_SIZE];
+    size_t header_len = encode_header(len, header);
+    size_t capacity = 0;
+
+    if ((msg || len == 0) && circular_buffer_get_current_capacity(ctx, &capacity) &&
+        header_len <= ctx->buff_size && len <= ctx->buff_size - header_len)
+    {
+        // Evict whole messages, oldest first, until the new one fits.
+        while (overwrite && capacity < header_len + len)
+        {
+            size_t old_header_len = 0, old_msg_len = 0;
+
+            if (!decode_header(ctx, &old_header_len, &old_msg_len) ||
+                !circular_buffer_consume(ctx, old_header_len + old_msg_len))
+            {
+                break;
+            }
+            ctx->overflow_count++;
+            capacity += old_header_len + old_msg_len;
+        }
+
+        // Copy the whole frame first and publish it once, so callbacks and stats never see
+        // a header without its payload.
+        if (capacity >= header_len + len)
+        {
+            copy_in_at(ctx, 0, header, header_len);
+            if (len > 0)
+            {
+                copy_in_at(ctx, header_len, msg, len);
+            }
+
+            ctx->head = (ctx->head + header_len + len) % ctx->buff_size;
+            ctx->current_byte_count += header_len + len;
+            CIRCULAR_BUFFER_STATS(circular_buffer_stats_add_pushed(ctx, header_len + len);)
+            CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_push(ctx, header_len + len);)
+            circular_buffer_check_watermarks(ctx);
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_frame_pop(circular_buffer_ctx *ctx, uint8_t *dst, size_t dst_size, size_t *len)
+{
+    bool res = false;
+    size_t header_len = 0, msg_len = 0;
+
+    if (dst && len && decode_header(ctx, &header_len, &msg_len) && msg_len <= dst_size)
+    {
+        res = circular_buffer_consume(ctx, header_len) &&
+              circular_buffer_read(ctx, dst, msg_len);
+        *len = msg_len;
+    }
+
+    return res;
+}
+
+bool circular_buffer_frame_peek(const circular_buffer_ctx *ctx, circular_buffer_frame_view *view)
+{
+    bool res = false;
+    size_t header_len = 0, msg_len = 0;
+
+    if (view && decode_header(ctx, &header_len, &msg_len))
+    {
+        size_t start = (ctx->tail + header_len) % ctx->buff_size;
+        size_t contiguous_len = ctx->buff_size - start;
+
+        view->first = &ctx->buffer[start];
+        view->first_len = (msg_len < contiguous_len) ? msg_len : contiguous_len;
+        view->second_len = msg_len - view->first_len;
+        view->second = (view->second_len > 0) ? &ctx->buffer[0] : NULL;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_frame_discard(circular_buffer_ctx *ctx)
+{
+    bool res = false;
+    size_t header_len = 0, msg_len = 0;
+
+    if (decode_header(ctx, &header_len, &msg_len))
+    {
+        res = circular_buffer_consume(ctx, header_len + msg_len);
+    }
+
+    return res;
+}
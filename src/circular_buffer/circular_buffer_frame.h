@@ -0,0 +1,80 @@
+/**
+ * @file circular_buffer_frame.h
+ * @brief Variable-length message framing on top of circular_buffer_ctx.
+ *
+ * Each message is stored as a compact length header (7 bits per byte, so messages under
+ * 128 bytes cost one extra byte) followed by its payload. Pushing a message is
+ * all-or-nothing and popping returns exactly one message, so the consumer never sees a
+ * torn frame. In overwrite mode whole oldest messages are evicted to make room, and the
+ * overflow count counts evicted messages instead of bytes.
+ *
+ * @note A ctx used in framed mode must only be accessed through these functions
+ * (plus the read-only queries in circular_buffer.h). Byte-wise pushes or pops would
+ * break the framing. Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_FRAME_H
+#define _CIRCULAR_BUFFER_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+// Longest possible length header, enough for any size_t.
+#define CIRCULAR_BUFFER_FRAME_MAX_HEADER_SIZE ((sizeof(size_t) * 8 + 6) / 7)
+
+// A message viewed in place. It is split in two if it wraps past the end of storage.
+typedef struct {
+    const uint8_t *first;
+    size_t first_len;
+    const uint8_t *second;     // NULL if the message does not wrap
+    size_t second_len;
+} circular_buffer_frame_view;
+
+/**
+ * @brief Adds one whole message to the buffer, or nothing at all.
+ *
+ * @param ctx A handle for the buffer.
+ * @param msg The message payload. May be NULL if len is 0.
+ * @param len The payload length. The payload plus its header must fit in the buffer.
+ * @param overwrite If true, whole oldest messages are evicted to make room.
+ *                  If false, fails when there is not enough free space.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_frame_push(circular_buffer_ctx *ctx, const uint8_t *msg, size_t len, bool overwrite);
+
+/**
+ * @brief Removes the oldest message from the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param dst A place to return the message payload.
+ * @param dst_size The size of dst. If the message does not fit, it stays in the buffer.
+ * @param len A pointer to return the payload length.
+ *
+ * @return true on success, false if the buffer is empty, dst is too small, or on invalid arguments.
+*/
+bool circular_buffer_frame_pop(circular_buffer_ctx *ctx, uint8_t *dst, size_t dst_size, size_t *len);
+
+/**
+ * @brief Exposes the oldest message in place without removing it.
+ * Release it with circular_buffer_frame_discard() once processed.
+ *
+ * @param ctx A handle for the buffer.
+ * @param view A pointer to return the message payload, in one or two pieces.
+ *
+ * @return true on success, false if the buffer is empty or on invalid arguments.
+*/
+bool circular_buffer_frame_peek(const circular_buffer_ctx *ctx, circular_buffer_frame_view *view);
+
+/**
+ * @brief Removes the oldest message without copying it out.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true on success, false if the buffer is empty or on invalid arguments.
+*/
+bool circular_buffer_frame_discard(circular_buffer_ctx *ctx);
+
+#endif /* _CIRCULAR_BUFFER_FRAME_H */
@@ -0,0 +1,262 @@
+/**
+ * @file circular_buffer_inline.h
+ * @brief Hot path of circular_buffer.h, shared by the regular and the inline build.
+ *
+ * Included at the end of circular_buffer.h. Do not include directly.
+ *
+ * The validity check and the unchecked variants are always static inline here.
+ * The checked hot operations are defined here too, either static inline in every
+ * including translation unit (CIRCULAR_BUFFER_INLINE_HOT_PATH) or exactly once,
+ * with external linkage, by circular_buffer.c (CIRCULAR_BUFFER_DEFINE_HOT_PATH).
+ */
+#ifndef _CIRCULAR_BUFFER_INLINE_H
+#define _CIRCULAR_BUFFER_INLINE_H
+
+/**
+ * @brief Defensive check: indices should always stay within buffer bounds,
+ * but we verify to guard against potential corruption/misuse.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if ctx is a usable, consistent buffer.
+ */
+static inline bool circular_buffer_ctx_is_valid(const circular_buffer_ctx *ctx) {
+    return ctx &&
+           ctx->buffer &&
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+           (ctx->buffer != ctx->storage || ctx->buff_size <= CIRCULAR_BUFFER_MAX_SIZE) &&
+#endif
+           ctx->buff_size > 0 &&
+           ctx->head < ctx->buff_size &&
+           ctx->tail < ctx->buff_size &&
+           ctx->current_byte_count <= ctx->buff_size;
+}
+
+/**
+ * @brief Fires the watermark callback if the last operation crossed a watermark.
+ * Called by every operation that changes the byte count, after the change.
+ *
+ * @param ctx A handle for the buffer. Must be valid.
+ */
+static inline void circular_buffer_check_watermarks(circular_buffer_ctx *ctx)
+{
+    if (ctx->watermark_cb)
+    {
+        if (!ctx->above_high && ctx->current_byte_count >= ctx->high_watermark)
+        {
+            ctx->above_high = true;
+            ctx->watermark_cb(CIRCULAR_BUFFER_WATERMARK_HIGH, ctx->current_byte_count, ctx->watermark_arg);
+        }
+        else if (ctx->above_high && ctx->current_byte_count <= ctx->low_watermark)
+        {
+            ctx->above_high = false;
+            ctx->watermark_cb(CIRCULAR_BUFFER_WATERMARK_LOW, ctx->current_byte_count, ctx->watermark_arg);
+        }
+    }
+}
+
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+#define CIRCULAR_BUFFER_STATS(statement) statement
+
+/**
+ * @brief Counts bytes added to the buffer and tracks the high water mark.
+ *
+ * @param ctx A handle for the buffer. Must be valid.
+ * @param len The number of bytes just added.
+ */
+static inline void circular_buffer_stats_add_pushed(circular_buffer_ctx *ctx, size_t len)
+{
+    ctx->stats.bytes_pushed += len;
+    if (ctx->current_byte_count > ctx->stats.high_water)
+    {
+        ctx->stats.high_water = ctx->current_byte_count;
+    }
+}
+#else
+#define CIRCULAR_BUFFER_STATS(statement)
+#endif
+
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+#define CIRCULAR_BUFFER_LATENCY(statement) statement
+#else
+#define CIRCULAR_BUFFER_LATENCY(statement)
+#endif
+
+/*
+ * Unchecked variants of the hot operations. They skip circular_buffer_ctx_is_valid()
+ * and all argument checks, for callers that validated the ctx once after init and own
+ * it from then on. ctx must be valid and data must not be NULL. Full and empty are
+ * still honored, with the same return values as the checked versions.
+ */
+
+static inline bool circular_buffer_push_with_overwrite_unchecked(circular_buffer_ctx *ctx, uint8_t data)
+{
+    // Buffer is full if true, overwrite mode.
+    if (ctx->current_byte_count == ctx->buff_size)
+    {
+        ctx->tail = (ctx->tail + 1) % ctx->buff_size;
+        ctx->current_byte_count--;
+        ctx->overflow_count++;
+        CIRCULAR_BUFFER_STATS(ctx->stats.bytes_overwritten++;)
+        CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_remove(ctx, 1);)
+    }
+
+    ctx->buffer[ctx->head] = data;
+    ctx->head = (ctx->head + 1) % ctx->buff_size;
+    ctx->current_byte_count++;
+    CIRCULAR_BUFFER_STATS(circular_buffer_stats_add_pushed(ctx, 1);)
+    CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_push(ctx, 1);)
+    circular_buffer_check_watermarks(ctx);
+
+    return true;
+}
+
+static inline bool circular_buffer_push_no_overwrite_unchecked(circular_buffer_ctx *ctx, uint8_t data)
+{
+    bool res = false;
+
+    if (ctx->current_byte_count < ctx->buff_size)
+    {
+        ctx->buffer[ctx->head] = data;
+        ctx->head = (ctx->head + 1) % ctx->buff_size;
+        ctx->current_byte_count++;
+        CIRCULAR_BUFFER_STATS(circular_buffer_stats_add_pushed(ctx, 1);)
+        CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_push(ctx, 1);)
+        circular_buffer_check_watermarks(ctx);
+
+        res = true;
+    }
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+    else
+    {
+        ctx->stats.rejected_pushes++;
+    }
+#endif
+
+    return res;
+}
+
+static inline bool circular_buffer_pop_unchecked(circular_buffer_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (ctx->current_byte_count > 0)
+    {
+        *data = ctx->buffer[ctx->tail];
+        ctx->tail = (ctx->tail + 1) % ctx->buff_size;
+        ctx->current_byte_count -= 1;
+        CIRCULAR_BUFFER_STATS(ctx->stats.bytes_popped++;)
+        CIRCULAR_BUFFER_LATENCY(circular_buffer_latency_on_remove(ctx, 1);)
+        circular_buffer_check_watermarks(ctx);
+        res = true;
+    }
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+    else
+    {
+        ctx->stats.empty_pops++;
+    }
+#endif
+
+    return res;
+}
+
+static inline bool circular_buffer_peek_unchecked(const circular_buffer_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (ctx->current_byte_count > 0)
+    {
+        *data = ctx->buffer[ctx->tail];
+        res = true;
+    }
+
+    return res;
+}
+
+static inline bool circular_buffer_is_empty_unchecked(const circular_buffer_ctx *ctx)
+{
+    return ctx->current_byte_count == 0;
+}
+
+static inline bool circular_buffer_is_full_unchecked(const circular_buffer_ctx *ctx)
+{
+    return ctx->current_byte_count == ctx->buff_size;
+}
+
+#if defined(CIRCULAR_BUFFER_INLINE_HOT_PATH) || defined(CIRCULAR_BUFFER_DEFINE_HOT_PATH)
+
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_push_with_overwrite(circular_buffer_ctx *ctx, uint8_t data)
+{
+    bool res = false;
+
+    if (circular_buffer_ctx_is_valid(ctx))
+    {
+        res = circular_buffer_push_with_overwrite_unchecked(ctx, data);
+    }
+
+    return res;
+}
+
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_push_no_overwrite(circular_buffer_ctx *ctx, uint8_t data)
+{
+    bool res = false;
+
+    if (circular_buffer_ctx_is_valid(ctx))
+    {
+        res = circular_buffer_push_no_overwrite_unchecked(ctx, data);
+    }
+
+    return res;
+}
+
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_pop(circular_buffer_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && circular_buffer_ctx_is_valid(ctx))
+    {
+        res = circular_buffer_pop_unchecked(ctx, data);
+    }
+
+    return res;
+}
+
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_peek(const circular_buffer_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && circular_buffer_ctx_is_valid(ctx))
+    {
+        res = circular_buffer_peek_unchecked(ctx, data);
+    }
+
+    return res;
+}
+
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_is_empty(const circular_buffer_ctx *ctx)
+{
+    bool res = true; // Consider a NULL ctx to be an empty buffer.
+
+    if (circular_buffer_ctx_is_valid(ctx))
+    {
+        res = circular_buffer_is_empty_unchecked(ctx);
+    }
+
+    return res;
+}
+
+CIRCULAR_BUFFER_HOT_API bool circular_buffer_is_full(const circular_buffer_ctx *ctx)
+{
+    bool res = false;
+
+    if (circular_buffer_ctx_is_valid(ctx))
+    {
+        res = circular_buffer_is_full_unchecked(ctx);
+    }
+
+    return res;
+}
+
+#endif /* CIRCULAR_BUFFER_INLINE_HOT_PATH || CIRCULAR_BUFFER_DEFINE_HOT_PATH */
+
+#endif /* _CIRCULAR_BUFFER_INLINE_H */
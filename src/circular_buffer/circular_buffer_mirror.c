@@ -0,0 +1,130 @@
+#define _GNU_SOURCE
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "circular_buffer_mirror.h"
+
+static bool ctx_is_valid(const circular_buffer_mirror_ctx *ctx)
+{
+    return ctx &&
+           ctx->mapping &&
+           ctx->ring.buffer == ctx->mapping &&
+           circular_buffer_ctx_is_valid(&ctx->ring);
+}
+
+// Reserves 2 * size bytes of address space, then maps the file over each half.
+static uint8_t *map_twice(int fd, size_t size)
+{
+    uint8_t *mapping = mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (mapping != MAP_FAILED)
+    {
+        if (mmap(mapping, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+            mmap(mapping + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+            (void)munmap(mapping, 2 * size);
+            mapping = MAP_FAILED;
+        }
+    }
+
+    return (mapping == MAP_FAILED) ? NULL : mapping;
+}
+
+bool circular_buffer_mirror_init(circular_buffer_mirror_ctx *ctx, size_t min_size)
+{
+    bool res = false;
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    // Both mappings must start on a page boundary, so the size is a whole number of pages.
+    if (ctx && page_size > 0 && 0 < min_size && min_size <= SIZE_MAX / 4)
+    {
+        size_t size = ((min_size + (size_t)page_size - 1) / (size_t)page_size) * (size_t)page_size;
+        int fd = memfd_create("circular_buffer", MFD_CLOEXEC);
+
+        ctx->mapping = NULL;
+
+        if (fd >= 0)
+        {
+            if (ftruncate(fd, (off_t)size) == 0)
+            {
+                ctx->mapping = map_twice(fd, size);
+            }
+            // The mappings keep the pages alive.
+            (void)close(fd);
+        }
+
+        if (ctx->mapping)
+        {
+            res = circular_buffer_init_with_storage(&ctx->ring, ctx->mapping, size);
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_mirror_destroy(circular_buffer_mirror_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx && ctx->mapping && munmap(ctx->mapping, 2 * ctx->ring.buff_size) == 0)
+    {
+        ctx->mapping = NULL;
+        ctx->ring.buffer = NULL;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_mirror_peek(const circular_buffer_mirror_ctx *ctx, const uint8_t **ptr, size_t *len)
+{
+    bool res = false;
+
+    if (ptr && len && ctx_is_valid(ctx) && ctx->ring.current_byte_count > 0)
+    {
+        // tail + count may run past the first mapping into the mirror.
+        *ptr = &ctx->mapping[ctx->ring.tail];
+        *len = ctx->ring.current_byte_count;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_mirror_reserve(circular_buffer_mirror_ctx *ctx, uint8_t **ptr, size_t *len)
+{
+    bool res = false;
+
+    if (ptr && len && ctx_is_valid(ctx) && ctx->ring.current_byte_count < ctx->ring.buff_size)
+    {
+        *ptr = &ctx->mapping[ctx->ring.head];
+        *len = ctx->ring.buff_size - ctx->ring.current_byte_count;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_mirror_commit(circular_buffer_mirror_ctx *ctx, size_t len)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && len <= ctx->ring.buff_size - ctx->ring.current_byte_count)
+    {
+        // The ring commits up to the end of its storage at most. Bytes written past it landed
+        // in the mirror, which is the start of the same pages, so they follow in a second step.
+        size_t to_end = ctx->ring.buff_size - ctx->ring.head;
+
+        if (len <= to_end)
+        {
+            res = circular_buffer_commit(&ctx->ring, len);
+        }
+        else
+        {
+            res = circular_buffer_commit(&ctx->ring, to_end) && circular_buffer_commit(&ctx->ring, len - to_end);
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file circular_buffer_mirror.h
+ * @brief A circular byte buffer whose storage is mapped twice, back to back, in virtual memory.
+ *
+ * The same memfd pages appear at storage[0] and at storage[buff_size], so any run of up to
+ * buff_size bytes starting inside the buffer is contiguous, even across the wrap point.
+ * All stored data can be handed to memchr(), a SIMD scan or write(2) as one span, and all
+ * free space can be filled by one read(2).
+ *
+ * The ctx wraps a regular circular_buffer_ctx. Push, pop, peek, write, read and consume are the
+ * circular_buffer.h API called on &ctx->ring, with the same semantics. Space handed out by
+ * circular_buffer_mirror_reserve() is published with circular_buffer_mirror_commit(), since
+ * circular_buffer_commit() stops at the end of storage.
+ *
+ * @note Linux only. Built when CIRCULAR_BUFFER_LINUX_EXTENSIONS is on.
+ * Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_MIRROR_H
+#define _CIRCULAR_BUFFER_MIRROR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+typedef struct {
+    circular_buffer_ctx ring;  // Runs over the first mapping. Use the circular_buffer.h API on it.
+    uint8_t *mapping;          // Start of both mappings, 2 * ring.buff_size bytes
+} circular_buffer_mirror_ctx;
+
+/**
+ * @brief Creates the double mapping and initializes the buffer over it.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param min_size The minimum size of the buffer. Rounded up to a multiple of the page size,
+ *                 the actual size is in ctx->ring.buff_size.
+ * @return true if success, false on invalid arguments or if the mapping could not be created.
+*/
+bool circular_buffer_mirror_init(circular_buffer_mirror_ctx *ctx, size_t min_size);
+
+/**
+ * @brief Unmaps the storage. The ctx must be initialized again before reuse.
+ *
+ * @param ctx A handle for the buffer.
+ * @return true if success.
+*/
+bool circular_buffer_mirror_destroy(circular_buffer_mirror_ctx *ctx);
+
+/**
+ * @brief Exposes all stored data, oldest first, as one contiguous span.
+ * Nothing is removed until circular_buffer_consume() is called on &ctx->ring.
+ *
+ * @param ctx A handle for the buffer.
+ * @param ptr A pointer to return the start of the stored data.
+ * @param len A pointer to return the number of bytes stored.
+ *
+ * @return true on success, false if the buffer is empty or on invalid arguments.
+*/
+bool circular_buffer_mirror_peek(const circular_buffer_mirror_ctx *ctx, const uint8_t **ptr, size_t *len);
+
+/**
+ * @brief Exposes all free space as one contiguous span, so a producer can fill it in place.
+ * Nothing is added until circular_buffer_mirror_commit() is called.
+ *
+ * @param ctx A handle for the buffer.
+ * @param ptr A pointer to return the start of the free space.
+ * @param len A pointer to return the number of free bytes.
+ *
+ * @return true on success, false if the buffer is full or on invalid arguments.
+*/
+bool circular_buffer_mirror_reserve(circular_buffer_mirror_ctx *ctx, uint8_t **ptr, size_t *len);
+
+/**
+ * @brief Publishes bytes written in place after circular_buffer_mirror_reserve(), including
+ * any that run across the wrap point into the mirror.
+ *
+ * @param ctx A handle for the buffer.
+ * @param len The number of bytes written. At most the reserved length.
+ *
+ * @return true on success, false if len exceeds the free space or on invalid arguments.
+*/
+bool circular_buffer_mirror_commit(circular_buffer_mirror_ctx *ctx, size_t len);
+
+#endif /* _CIRCULAR_BUFFER_MIRROR_H */
@@ -0,0 +1,198 @@
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "circular_buffer_mpmc.h"
+
+// Slot sequence protocol: a slot at position pos is free for a producer when its
+// sequence equals pos, and holds data for a consumer when it equals pos + 1. After
+// popping, the consumer sets it to pos + buff_size, the producer's position one lap later.
+
+static bool size_is_valid(size_t buff_size)
+{
+    return 0 < buff_size && (buff_size & (buff_size - 1)) == 0;
+}
+
+static bool ctx_is_valid(const circular_buffer_mpmc_ctx *ctx) {
+    return ctx &&
+           ctx->slots &&
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+           (ctx->slots != ctx->storage || ctx->buff_size <= CIRCULAR_BUFFER_MAX_SIZE) &&
+#endif
+           size_is_valid(ctx->buff_size);
+}
+
+// Distance between a slot's sequence and the position we want, wrap-safe.
+static ptrdiff_t sequence_distance(size_t sequence, size_t position)
+{
+    return (ptrdiff_t)(sequence - position);
+}
+
+// Snapshot of the byte count. Loads head and tail separately, so only approximate.
+static size_t approximate_count(const circular_buffer_mpmc_ctx *ctx)
+{
+    size_t tail = atomic_load_explicit(&ctx->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ctx->head, memory_order_acquire);
+    size_t count = head - tail;
+
+    // A pop can move tail past a head loaded earlier, which would look like a huge count.
+    return ((ptrdiff_t)count < 0) ? 0 : count;
+}
+
+bool circular_buffer_mpmc_init(circular_buffer_mpmc_ctx *ctx, size_t buff_size)
+{
+    bool res = false;
+
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    if (ctx && buff_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        res = circular_buffer_mpmc_init_with_storage(ctx, ctx->storage, buff_size);
+    }
+#else
+    (void)ctx;
+    (void)buff_size;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_mpmc_init_with_storage(circular_buffer_mpmc_ctx *ctx, circular_buffer_mpmc_slot *slots, size_t slot_count)
+{
+    bool res = false;
+
+    if (ctx && slots && size_is_valid(slot_count))
+    {
+        ctx->buff_size = slot_count;
+        ctx->slots = slots;
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            atomic_init(&slots[i].sequence, i);
+        }
+        atomic_init(&ctx->head, 0);
+        atomic_init(&ctx->tail, 0);
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_mpmc_push(circular_buffer_mpmc_ctx *ctx, uint8_t data)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx))
+    {
+        size_t mask = ctx->buff_size - 1;
+        size_t position = atomic_load_explicit(&ctx->head, memory_order_relaxed);
+        circular_buffer_mpmc_slot *slot = NULL;
+
+        for (;;)
+        {
+            slot = &ctx->slots[position & mask];
+            size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+            ptrdiff_t distance = sequence_distance(sequence, position);
+
+            if (distance == 0)
+            {
+                // The slot is free. Claim the position; on failure position is reloaded.
+                if (atomic_compare_exchange_weak_explicit(&ctx->head, &position, position + 1,
+                                                          memory_order_relaxed, memory_order_relaxed))
+                {
+                    res = true;
+                    break;
+                }
+            }
+            else if (distance < 0)
+            {
+                // The slot still holds last lap's data. Buffer is full.
+                break;
+            }
+            else
+            {
+                // Another producer claimed this position first.
+                position = atomic_load_explicit(&ctx->head, memory_order_relaxed);
+            }
+        }
+
+        if (res)
+        {
+            slot->data = data;
+            // Release publishes the byte to the consumer that claims this position.
+            atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_mpmc_pop(circular_buffer_mpmc_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && ctx_is_valid(ctx))
+    {
+        size_t mask = ctx->buff_size - 1;
+        size_t position = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+        circular_buffer_mpmc_slot *slot = NULL;
+
+        for (;;)
+        {
+            slot = &ctx->slots[position & mask];
+            size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+            ptrdiff_t distance = sequence_distance(sequence, position + 1);
+
+            if (distance == 0)
+            {
+                // The slot holds data. Claim the position; on failure position is reloaded.
+                if (atomic_compare_exchange_weak_explicit(&ctx->tail, &position, position + 1,
+                                                          memory_order_relaxed, memory_order_relaxed))
+                {
+                    res = true;
+                    break;
+                }
+            }
+            else if (distance < 0)
+            {
+                // Nothing has been published here yet. Buffer is empty.
+                break;
+            }
+            else
+            {
+                // Another consumer claimed this position first.
+                position = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+            }
+        }
+
+        if (res)
+        {
+            *data = slot->data;
+            // Release hands the slot to the producer one lap ahead, after the byte is read.
+            atomic_store_explicit(&slot->sequence, position + ctx->buff_size, memory_order_release);
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_mpmc_is_empty(const circular_buffer_mpmc_ctx *ctx)
+{
+    bool res = true; // Consider a NULL ctx to be an empty buffer.
+
+    if (ctx_is_valid(ctx) && approximate_count(ctx) > 0)
+    {
+        res = false;
+    }
+
+    return res;
+}
+
+bool circular_buffer_mpmc_is_full(const circular_buffer_mpmc_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && approximate_count(ctx) >= ctx->buff_size)
+    {
+        res = true;
+    }
+
+    return res;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file circular_buffer_mpmc.h
+ * @brief A lock-free multi-producer/multi-consumer variant of the circular byte buffer.
+ *
+ * Each slot carries a sequence number that says whose turn it is: producers claim
+ * positions from head and consumers from tail with a compare-and-swap, then hand the
+ * slot over by publishing its next sequence number. Push and pop never block, and a
+ * thread only retries when another thread won the same position, so contention stays
+ * bounded to the threads racing for one slot.
+ *
+ * @note Any number of threads may push and pop concurrently. Init is not thread-safe
+ * and must finish before any other call. Never overwrites: push fails when full.
+ * is_empty and is_full are snapshots that may be stale by the time they return.
+ */
+#ifndef _CIRCULAR_BUFFER_MPMC_H
+#define _CIRCULAR_BUFFER_MPMC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+#include "circular_buffer_atomic.h"
+
+typedef struct {
+    CIRCULAR_BUFFER_ATOMIC(size_t) sequence;  // Position this slot is ready for
+    uint8_t data;
+} circular_buffer_mpmc_slot;
+
+typedef struct {
+    size_t buff_size;                         // Power of two, up to MAX_SIZE with embedded storage
+    circular_buffer_mpmc_slot *slots;         // Points at the embedded storage or the caller's slots
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    circular_buffer_mpmc_slot storage[CIRCULAR_BUFFER_MAX_SIZE];
+#endif
+    CIRCULAR_BUFFER_ATOMIC(size_t) head;      // Next position to push, free-running
+    CIRCULAR_BUFFER_ATOMIC(size_t) tail;      // Next position to pop, free-running
+} circular_buffer_mpmc_ctx;
+
+/**
+ * @brief Initializes an instance of the multi-producer/multi-consumer buffer.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param buff_size The size of the buffer to instantiate. Must be a power of two
+ *                  and less than or equal to MAX_BUFFER_SIZE.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_mpmc_init(circular_buffer_mpmc_ctx *ctx, size_t buff_size);
+
+/**
+ * @brief Initializes an instance of the multi-producer/multi-consumer buffer over caller-provided slots.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param slots The slots to use. Must stay valid for the life of the buffer.
+ * @param slot_count The number of slots, which becomes the size of the buffer. Must be a power of two.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_mpmc_init_with_storage(circular_buffer_mpmc_ctx *ctx, circular_buffer_mpmc_slot *slots, size_t slot_count);
+
+/**
+ * @brief Adds an item to the buffer. Safe from any thread.
+ * Never overwrites data in buffer. Fails if buffer is full.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A piece of data to push.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_mpmc_push(circular_buffer_mpmc_ctx *ctx, uint8_t data);
+
+/**
+ * @brief Removes an item from the buffer. Safe from any thread.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A pointer to return popped data.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_mpmc_pop(circular_buffer_mpmc_ctx *ctx, uint8_t *data);
+
+/**
+ * @brief Use to check if there is anything in the buffer. Approximate under concurrency.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is empty or if the ctx is NULL, false if there
+ *          are items in the buffer.
+ */
+bool circular_buffer_mpmc_is_empty(const circular_buffer_mpmc_ctx *ctx);
+
+/**
+ * @brief Use to check if the buffer is full. Approximate under concurrency.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is full and false if it is not full.
+ */
+bool circular_buffer_mpmc_is_full(const circular_buffer_mpmc_ctx *ctx);
+
+#endif /* _CIRCULAR_BUFFER_MPMC_H */
@@ -0,0 +1,243 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "circular_buffer_persist.h"
+
+// The ctx and the storage each start on their own cache line.
+#define PERSIST_ALIGNMENT 64u
+
+static size_t align_up(size_t offset)
+{
+    return (offset + PERSIST_ALIGNMENT - 1) & ~(size_t)(PERSIST_ALIGNMENT - 1);
+}
+
+static size_t ctx_offset(void)
+{
+    return align_up(sizeof(circular_buffer_persist_header));
+}
+
+static size_t storage_offset(void)
+{
+    return align_up(ctx_offset() + sizeof(circular_buffer_ctx));
+}
+
+static bool ctx_is_valid(const circular_buffer_persist_ctx *ctx)
+{
+    return ctx &&
+           ctx->mapping &&
+           ctx->fd >= 0 &&
+           ctx->ring == (circular_buffer_ctx *)(ctx->mapping + ctx_offset());
+}
+
+// Checks a mapped header against this build and the size of the file it came from.
+static bool header_is_valid(const circular_buffer_persist_header *header, size_t file_size)
+{
+    return header->magic == CIRCULAR_BUFFER_PERSIST_MAGIC &&
+           header->version == CIRCULAR_BUFFER_PERSIST_VERSION &&
+           header->ctx_size == sizeof(circular_buffer_ctx) &&
+           header->ctx_offset == ctx_offset() &&
+           header->storage_offset == storage_offset() &&
+           header->storage_size > 0 &&
+           header->storage_size == file_size - storage_offset();
+}
+
+// The index checks of circular_buffer_ctx_is_valid(), plus the relation between the indices and
+// the count that every operation keeps. A process killed in the middle of an operation can break
+// it. Only reads the ring, whose buffer pointer is still the previous process's.
+static bool ring_is_consistent(const circular_buffer_ctx *ring, size_t storage_size)
+{
+    return ring->buff_size == storage_size &&
+           ring->head < ring->buff_size &&
+           ring->tail < ring->buff_size &&
+           ring->current_byte_count <= ring->buff_size &&
+           (ring->tail + ring->current_byte_count) % ring->buff_size == ring->head;
+}
+
+// Opens path and takes the exclusive lock that is held until circular_buffer_persist_close().
+// Returns -1 with errno set, EWOULDBLOCK if another handle has the file open.
+static int open_locked(const char *path, int flags)
+{
+    int fd = open(path, flags | O_CLOEXEC, 0644);
+
+    if (fd >= 0 && flock(fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        int lock_errno = errno;
+
+        (void)close(fd);
+        fd = -1;
+        errno = lock_errno;
+    }
+
+    return fd;
+}
+
+// Maps len bytes of fd shared, so stores go straight to the file's pages.
+static uint8_t *map_file(int fd, size_t len)
+{
+    uint8_t *mapping = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    return (mapping == MAP_FAILED) ? NULL : mapping;
+}
+
+bool circular_buffer_persist_create(circular_buffer_persist_ctx *ctx, const char *path, size_t buff_size)
+{
+    bool res = false;
+
+    if (ctx && path && 0 < buff_size && buff_size <= SIZE_MAX / 4)
+    {
+        size_t file_size = storage_offset() + buff_size;
+
+        // Not O_TRUNC: the old contents may only go once the lock is held.
+        ctx->fd = open_locked(path, O_RDWR | O_CREAT);
+        ctx->mapping = NULL;
+
+        if (ctx->fd >= 0)
+        {
+            if (ftruncate(ctx->fd, 0) == 0 && ftruncate(ctx->fd, (off_t)file_size) == 0)
+            {
+                ctx->mapping = map_file(ctx->fd, file_size);
+            }
+            if (!ctx->mapping)
+            {
+                (void)close(ctx->fd);
+                ctx->fd = -1;
+            }
+        }
+
+        if (ctx->mapping)
+        {
+            circular_buffer_persist_header *header = (circular_buffer_persist_header *)ctx->mapping;
+
+            ctx->mapping_size = file_size;
+            ctx->ring = (circular_buffer_ctx *)(ctx->mapping + ctx_offset());
+            header->version = CIRCULAR_BUFFER_PERSIST_VERSION;
+            header->ctx_size = sizeof(circular_buffer_ctx);
+            header->reserved = 0;
+            header->ctx_offset = ctx_offset();
+            header->storage_offset = storage_offset();
+            header->storage_size = buff_size;
+            res = circular_buffer_init_with_storage(ctx->ring, ctx->mapping + storage_offset(), buff_size);
+
+            // Stamp the magic only once everything else is in place.
+            atomic_signal_fence(memory_order_release);
+            header->magic = CIRCULAR_BUFFER_PERSIST_MAGIC;
+        }
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+    return res;
+}
+
+bool circular_buffer_persist_recover(circular_buffer_persist_ctx *ctx, const char *path)
+{
+    bool res = false;
+
+    if (ctx && path)
+    {
+        struct stat file_stat;
+
+        // The lock comes first, so the file is only written while no other handle has it open.
+        ctx->fd = open_locked(path, O_RDWR);
+        ctx->mapping = NULL;
+
+        if (ctx->fd >= 0)
+        {
+            if (fstat(ctx->fd, &file_stat) == 0)
+            {
+                if ((size_t)file_stat.st_size > storage_offset())
+                {
+                    ctx->mapping_size = (size_t)file_stat.st_size;
+                    ctx->mapping = map_file(ctx->fd, ctx->mapping_size);
+                }
+                else
+                {
+                    errno = EINVAL;
+                }
+            }
+        }
+
+        if (ctx->mapping)
+        {
+            const circular_buffer_persist_header *header = (const circular_buffer_persist_header *)ctx->mapping;
+            circular_buffer_ctx *ring = (circular_buffer_ctx *)(ctx->mapping + ctx_offset());
+
+            // Validate everything before the first write to the file.
+            if (header_is_valid(header, ctx->mapping_size) && ring_is_consistent(ring, header->storage_size))
+            {
+                // Rebind everything that pointed into the previous process.
+                ring->buffer = ctx->mapping + storage_offset();
+                ring->watermark_cb = NULL;
+                ring->watermark_arg = NULL;
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+                ring->latency.clock = NULL;
+                ring->latency.clock_arg = NULL;
+                ring->latency.mark_count = 0;
+#endif
+                ctx->ring = ring;
+                res = true;
+            }
+            else
+            {
+                (void)munmap(ctx->mapping, ctx->mapping_size);
+                ctx->mapping = NULL;
+                errno = EINVAL;
+            }
+        }
+
+        if (!res && ctx->fd >= 0)
+        {
+            int recover_errno = errno;
+
+            (void)close(ctx->fd);
+            ctx->fd = -1;
+            errno = recover_errno;
+        }
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+    return res;
+}
+
+bool circular_buffer_persist_sync(circular_buffer_persist_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx))
+    {
+        res = (msync(ctx->mapping, ctx->mapping_size, MS_SYNC) == 0);
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+    return res;
+}
+
+bool circular_buffer_persist_close(circular_buffer_persist_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && munmap(ctx->mapping, ctx->mapping_size) == 0)
+    {
+        // Closing the file releases the lock.
+        (void)close(ctx->fd);
+        ctx->fd = -1;
+        ctx->mapping = NULL;
+        ctx->ring = NULL;
+        res = true;
+    }
+
+    return res;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file circular_buffer_persist.h
+ * @brief A circular byte buffer kept in a memory-mapped file, so its contents survive a crash
+ * or restart of the process.
+ *
+ * The file holds a versioned header, the circular_buffer_ctx itself and the storage. Every
+ * operation on &ctx->ring updates the file's pages directly, so there is nothing to flush on the
+ * way down: if the process dies, the kernel still has the pages and the next process, or a
+ * post-mortem tool, finds the buffer exactly as it was left. circular_buffer_persist_sync()
+ * additionally makes it survive a power loss.
+ *
+ * File layout, all offsets from the start of the file:
+ *   0               circular_buffer_persist_header
+ *   ctx_offset      circular_buffer_ctx (in the layout of the build that wrote it, see ctx_size)
+ *   storage_offset  storage_size bytes of buffer storage
+ *
+ * @note The ctx holds a pointer into the mapping and the build-dependent layout of
+ * circular_buffer_ctx, so a file can only be recovered by a build with the same ctx_size, and
+ * the pointer is rebound on recovery. Not thread-safe, same as circular_buffer.h.
+ *
+ * Only one handle may have a file open at a time, in this process or any other. Create and
+ * recover take an exclusive flock() on the file and hold it until circular_buffer_persist_close(),
+ * or until the process exits, so a second handle cannot rebind a ring that a live one is using.
+ */
+#ifndef _CIRCULAR_BUFFER_PERSIST_H
+#define _CIRCULAR_BUFFER_PERSIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+#define CIRCULAR_BUFFER_PERSIST_MAGIC   0x46504243u  // "CBPF" in a little-endian file
+#define CIRCULAR_BUFFER_PERSIST_VERSION 1u
+
+typedef struct {
+    uint32_t magic;            // CIRCULAR_BUFFER_PERSIST_MAGIC, written last so a half-created file is rejected
+    uint32_t version;          // CIRCULAR_BUFFER_PERSIST_VERSION
+    uint32_t ctx_size;         // sizeof(circular_buffer_ctx) in the build that created the file
+    uint32_t reserved;
+    uint64_t ctx_offset;
+    uint64_t storage_offset;
+    uint64_t storage_size;
+} circular_buffer_persist_header;
+
+typedef struct {
+    circular_buffer_ctx *ring;  // Lives in the mapping. Use the circular_buffer.h API on it.
+    uint8_t *mapping;           // Start of the mapped file
+    size_t mapping_size;
+    int fd;                     // Kept open to hold the file's exclusive lock
+} circular_buffer_persist_ctx;
+
+/**
+ * @brief Creates (or truncates) the file at path and initializes an empty buffer in it.
+ * The file is only truncated once its lock is held, so a file open elsewhere is left untouched.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param path The file to use.
+ * @param buff_size The size of the buffer in bytes.
+ * @return true if success. false with errno set otherwise: EINVAL on invalid arguments,
+ *         EWOULDBLOCK if another handle has the file open, or the error from creating, sizing
+ *         or mapping the file.
+*/
+bool circular_buffer_persist_create(circular_buffer_persist_ctx *ctx, const char *path, size_t buff_size);
+
+/**
+ * @brief Maps an existing file and reattaches to the buffer in it, with the head, tail, byte
+ * count and overflow count the last process left. Nothing is copied or replayed.
+ *
+ * The header must match this build, and the ctx must pass the same checks as
+ * circular_buffer_ctx_is_valid() plus tail + count == head modulo the size, which a process
+ * killed in the middle of an operation can leave broken. All of this is checked before anything
+ * is written. The watermark callback (and the latency clock) point into the process that wrote
+ * the file, so they are cleared.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param path The file to recover.
+ * @return true if success. false with errno set otherwise: EINVAL if the file is not a valid
+ *         buffer for this build, EWOULDBLOCK if another handle has the file open, or the error
+ *         from opening or mapping it.
+*/
+bool circular_buffer_persist_recover(circular_buffer_persist_ctx *ctx, const char *path);
+
+/**
+ * @brief Writes the mapped pages back to the file and waits for the write, so the current
+ * contents also survive a power loss or kernel crash. Not needed to survive a process crash.
+ *
+ * @param ctx A handle for the buffer.
+ * @return true if success. false with errno set otherwise.
+*/
+bool circular_buffer_persist_sync(circular_buffer_persist_ctx *ctx);
+
+/**
+ * @brief Unmaps the file and releases its lock. The file keeps the buffer, ready for
+ * circular_buffer_persist_recover().
+ *
+ * @param ctx A handle for the buffer.
+ * @return true if success.
+*/
+bool circular_buffer_persist_close(circular_buffer_persist_ctx *ctx);
+
+#endif /* _CIRCULAR_BUFFER_PERSIST_H */
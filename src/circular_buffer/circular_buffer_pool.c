@@ -0,0 +1,180 @@
+#include <string.h>
+
+#include "circular_buffer_pool.h"
+
+// The free list link is stored in the first bytes of a free block. Blocks have no alignment
+// beyond a byte, so the link is always copied with memcpy rather than dereferenced in place.
+
+static uint8_t *next_free(const uint8_t *block)
+{
+    uint8_t *next;
+
+    memcpy(&next, block, sizeof(next));
+    return next;
+}
+
+static void set_next_free(uint8_t *block, uint8_t *next)
+{
+    memcpy(block, &next, sizeof(next));
+}
+
+static bool pool_is_valid(const circular_buffer_pool *pool)
+{
+    return pool &&
+           pool->class_count > 0 &&
+           pool->class_count <= CIRCULAR_BUFFER_POOL_MAX_CLASSES;
+}
+
+// The class whose blocks contain buffer, or class_count if none does.
+static size_t class_of(const circular_buffer_pool *pool, const uint8_t *buffer)
+{
+    size_t found = pool->class_count;
+
+    for (size_t i = 0; found == pool->class_count && i < pool->class_count; i++)
+    {
+        const circular_buffer_pool_class *pool_class = &pool->classes[i];
+        size_t span = pool_class->usage.block_size * pool_class->usage.block_count;
+
+        if (buffer >= pool_class->first && buffer < pool_class->first + span)
+        {
+            found = i;
+        }
+    }
+
+    return found;
+}
+
+bool circular_buffer_pool_init(circular_buffer_pool *pool, uint8_t *arena, size_t arena_len,
+                               const size_t *block_sizes, const size_t *block_counts, size_t class_count)
+{
+    bool res = false;
+
+    if (pool && arena && block_sizes && block_counts &&
+        0 < class_count && class_count <= CIRCULAR_BUFFER_POOL_MAX_CLASSES)
+    {
+        size_t used = 0;
+
+        res = true;
+        for (size_t i = 0; res && i < class_count; i++)
+        {
+            size_t size = block_sizes[i];
+            size_t count = block_counts[i];
+
+            // Written so that the running total cannot overflow.
+            res = size >= sizeof(uint8_t *) && size <= SIZE_MAX / 2 && count > 0 &&
+                  (i == 0 || size > block_sizes[i - 1]) &&
+                  count <= (arena_len - used) / size;
+            if (res)
+            {
+                used += size * count;
+            }
+        }
+
+        if (res)
+        {
+            uint8_t *next_class = arena;
+
+            pool->class_count = class_count;
+            for (size_t i = 0; i < class_count; i++)
+            {
+                circular_buffer_pool_class *pool_class = &pool->classes[i];
+
+                pool_class->first = next_class;
+                pool_class->free_list = NULL;
+                pool_class->usage.block_size = block_sizes[i];
+                pool_class->usage.block_count = block_counts[i];
+                pool_class->usage.in_use = 0;
+                pool_class->usage.high_water = 0;
+
+                // Thread the list back to front, so blocks are handed out in address order.
+                for (size_t b = block_counts[i]; b > 0; b--)
+                {
+                    uint8_t *block = next_class + (b - 1) * block_sizes[i];
+                    set_next_free(block, pool_class->free_list);
+                    pool_class->free_list = block;
+                }
+
+                next_class += block_sizes[i] * block_counts[i];
+            }
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_pool_acquire(circular_buffer_pool *pool, circular_buffer_ctx *ctx, size_t min_size)
+{
+    bool res = false;
+
+    if (ctx && pool_is_valid(pool) && min_size > 0)
+    {
+        // At most CIRCULAR_BUFFER_POOL_MAX_CLASSES steps. Falls through to a larger class when
+        // the best fit is exhausted.
+        for (size_t i = 0; !res && i < pool->class_count; i++)
+        {
+            circular_buffer_pool_class *pool_class = &pool->classes[i];
+
+            if (pool_class->usage.block_size >= min_size && pool_class->free_list)
+            {
+                uint8_t *block = pool_class->free_list;
+
+                if (circular_buffer_init_with_storage(ctx, block, pool_class->usage.block_size))
+                {
+                    pool_class->free_list = next_free(block);
+                    pool_class->usage.in_use++;
+                    if (pool_class->usage.in_use > pool_class->usage.high_water)
+                    {
+                        pool_class->usage.high_water = pool_class->usage.in_use;
+                    }
+                    res = true;
+                }
+            }
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_pool_release(circular_buffer_pool *pool, circular_buffer_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx && ctx->buffer && pool_is_valid(pool))
+    {
+        size_t i = class_of(pool, ctx->buffer);
+
+        if (i < pool->class_count)
+        {
+            circular_buffer_pool_class *pool_class = &pool->classes[i];
+
+            // Only whole blocks handed out by acquire go back on the list.
+            if ((size_t)(ctx->buffer - pool_class->first) % pool_class->usage.block_size == 0 &&
+                ctx->buff_size == pool_class->usage.block_size &&
+                pool_class->usage.in_use > 0)
+            {
+                set_next_free(ctx->buffer, pool_class->free_list);
+                pool_class->free_list = ctx->buffer;
+                pool_class->usage.in_use--;
+                // Make any further use of the ctx fail instead of touching a block someone else may own.
+                ctx->buffer = NULL;
+                res = true;
+            }
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_pool_get_usage(const circular_buffer_pool *pool, size_t class_index,
+                                    circular_buffer_pool_usage *usage)
+{
+    bool res = false;
+
+    if (usage && pool_is_valid(pool) && class_index < pool->class_count)
+    {
+        *usage = pool->classes[class_index].usage;
+        res = true;
+    }
+
+    return res;
+}
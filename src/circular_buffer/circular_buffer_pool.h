@@ -0,0 +1,93 @@
+/**
+ * @file circular_buffer_pool.h
+ * @brief Hands out ring storage from one preallocated arena, in a few fixed size classes.
+ *
+ * For programs with many buffers of different sizes (e.g. one per connection), each sized for
+ * what it carries rather than for CIRCULAR_BUFFER_MAX_SIZE. Every class is a run of equal blocks
+ * with an intrusive free list threaded through the free blocks, so acquire and release are
+ * constant time, need no malloc, and cannot fragment the arena.
+ *
+ * A pooled buffer is a regular circular_buffer_ctx initialized with circular_buffer_init_with_storage()
+ * over a block, used with the circular_buffer.h API. Build with CIRCULAR_BUFFER_MAX_SIZE=0 so the
+ * ctx itself does not also carry worst-case embedded storage.
+ *
+ * @note Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_POOL_H
+#define _CIRCULAR_BUFFER_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+#ifndef CIRCULAR_BUFFER_POOL_MAX_CLASSES
+#define CIRCULAR_BUFFER_POOL_MAX_CLASSES 8
+#endif
+
+typedef struct {
+    size_t block_size;         // Bytes of storage per buffer in this class
+    size_t block_count;
+    size_t in_use;
+    size_t high_water;         // Most blocks ever in use at once
+} circular_buffer_pool_usage;
+
+typedef struct {
+    uint8_t *first;            // First block of the class in the arena
+    uint8_t *free_list;        // First free block. Each free block starts with a pointer to the next.
+    circular_buffer_pool_usage usage;
+} circular_buffer_pool_class;
+
+typedef struct {
+    circular_buffer_pool_class classes[CIRCULAR_BUFFER_POOL_MAX_CLASSES];  // Ascending block sizes
+    size_t class_count;
+} circular_buffer_pool;
+
+/**
+ * @brief Carves the arena into size classes, each a run of block_counts[i] blocks of block_sizes[i] bytes.
+ *
+ * @param pool A blank handle for the pool.
+ * @param arena The memory to carve up. Must stay valid for the life of the pool.
+ * @param arena_len The size of arena in bytes. Must hold the sum of block_sizes[i] * block_counts[i].
+ * @param block_sizes The block size of each class, strictly ascending, each at least sizeof(uint8_t *).
+ * @param block_counts The number of blocks in each class, each at least 1.
+ * @param class_count The number of classes, 1 to CIRCULAR_BUFFER_POOL_MAX_CLASSES.
+ * @return true if success, false on invalid arguments.
+*/
+bool circular_buffer_pool_init(circular_buffer_pool *pool, uint8_t *arena, size_t arena_len,
+                               const size_t *block_sizes, const size_t *block_counts, size_t class_count);
+
+/**
+ * @brief Takes a block from the smallest class that fits min_size and has one free, and initializes
+ * ctx over it. The buffer's size is the class's block size, which may be larger than min_size.
+ *
+ * @param pool A handle for the pool.
+ * @param ctx A blank handle for the buffer.
+ * @param min_size The smallest buffer size acceptable.
+ * @return true if success, false on invalid arguments or if no class that fits has a free block.
+*/
+bool circular_buffer_pool_acquire(circular_buffer_pool *pool, circular_buffer_ctx *ctx, size_t min_size);
+
+/**
+ * @brief Returns the block of a buffer acquired from this pool. Any data in it is discarded and
+ * the ctx must be acquired or initialized again before reuse.
+ *
+ * @param pool A handle for the pool.
+ * @param ctx A handle for the buffer.
+ * @return true if success, false on invalid arguments or if the ctx does not hold a block of this pool.
+*/
+bool circular_buffer_pool_release(circular_buffer_pool *pool, circular_buffer_ctx *ctx);
+
+/**
+ * @brief Use to retrieve how full a size class is.
+ *
+ * @param pool A handle for the pool.
+ * @param class_index The class, 0 for the smallest.
+ * @param usage A pointer to return the class's block size, block count, blocks in use and high water mark.
+ * @return true on success, false on invalid arguments.
+*/
+bool circular_buffer_pool_get_usage(const circular_buffer_pool *pool, size_t class_index,
+                                    circular_buffer_pool_usage *usage);
+
+#endif /* _CIRCULAR_BUFFER_POOL_H */
@@ -0,0 +1,179 @@
+#include "circular_buffer_pow2.h"
+
+static bool size_is_valid(size_t buff_size)
+{
+    return 0 < buff_size && (buff_size & (buff_size - 1)) == 0;
+}
+
+// Defensive check: the distance between the free-running indices
+// can never exceed the buffer size unless the ctx was corrupted.
+static bool ctx_is_valid(const circular_buffer_pow2_ctx *ctx) {
+    return ctx &&
+           ctx->buffer &&
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+           (ctx->buffer != ctx->storage || ctx->buff_size <= CIRCULAR_BUFFER_MAX_SIZE) &&
+#endif
+           size_is_valid(ctx->buff_size) &&
+           (ctx->head - ctx->tail) <= ctx->buff_size;
+}
+
+bool circular_buffer_pow2_init(circular_buffer_pow2_ctx *ctx, size_t buff_size)
+{
+    bool res = false;
+
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    if (ctx && buff_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        res = circular_buffer_pow2_init_with_storage(ctx, ctx->storage, buff_size);
+    }
+#else
+    (void)ctx;
+    (void)buff_size;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_pow2_init_with_storage(circular_buffer_pow2_ctx *ctx, uint8_t *mem, size_t len)
+{
+    bool res = false;
+
+    if (ctx && mem && size_is_valid(len))
+    {
+        ctx->buff_size = len;
+        ctx->buffer = mem;
+        ctx->head = 0;
+        ctx->tail = 0;
+        ctx->overflow_count = 0;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_push_with_overwrite(circular_buffer_pow2_ctx *ctx, uint8_t data)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx))
+    {
+        // Buffer is full if true, overwrite mode.
+        if (ctx->head - ctx->tail == ctx->buff_size)
+        {
+            ctx->tail++;
+            ctx->overflow_count++;
+        }
+
+        ctx->buffer[ctx->head & (ctx->buff_size - 1)] = data;
+        ctx->head++;
+
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_push_no_overwrite(circular_buffer_pow2_ctx *ctx, uint8_t data)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && ctx->head - ctx->tail < ctx->buff_size)
+    {
+        ctx->buffer[ctx->head & (ctx->buff_size - 1)] = data;
+        ctx->head++;
+
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_pop(circular_buffer_pow2_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && ctx_is_valid(ctx) && ctx->head != ctx->tail)
+    {
+        *data = ctx->buffer[ctx->tail & (ctx->buff_size - 1)];
+        ctx->tail++;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_peek(const circular_buffer_pow2_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && ctx_is_valid(ctx) && ctx->head != ctx->tail)
+    {
+        *data = ctx->buffer[ctx->tail & (ctx->buff_size - 1)];
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_is_empty(const circular_buffer_pow2_ctx *ctx)
+{
+    bool res = true; // Consider a NULL ctx to be an empty buffer.
+
+    if (ctx_is_valid(ctx) && ctx->head != ctx->tail)
+    {
+        res = false;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_is_full(const circular_buffer_pow2_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && ctx->head - ctx->tail == ctx->buff_size)
+    {
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_get_current_capacity(const circular_buffer_pow2_ctx *ctx, size_t *capacity)
+{
+    bool res = false;
+
+    if (capacity && ctx_is_valid(ctx))
+    {
+        *capacity = ctx->buff_size - (ctx->head - ctx->tail);
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_get_overflow_count(const circular_buffer_pow2_ctx *ctx, uint32_t *overflow_count)
+{
+    bool res = false;
+
+    if (overflow_count && ctx_is_valid(ctx))
+    {
+        *overflow_count = ctx->overflow_count;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_pow2_clear_overflow_count(circular_buffer_pow2_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx))
+    {
+        ctx->overflow_count = 0;
+        res = true;
+    }
+
+    return res;
+}
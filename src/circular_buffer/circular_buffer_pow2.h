@@ -0,0 +1,143 @@
+/**
+ * @file circular_buffer_pow2.h
+ * @brief A circular byte buffer restricted to power-of-two sizes, so indices wrap with a
+ * mask instead of a modulo (integer division is slow or absent on small cores like the Cortex-M0).
+ *
+ * Head and tail are free-running counters that are only masked when indexing storage.
+ * Since the size divides the range of size_t, head - tail is the byte count even after
+ * the counters roll over, so no separate counter is kept.
+ *
+ * @note Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_POW2_H
+#define _CIRCULAR_BUFFER_POW2_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+typedef struct {
+    size_t buff_size;          // Power of two, up to MAX_SIZE with embedded storage
+    uint8_t *buffer;           // Points at the embedded storage or the caller's memory
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    uint8_t storage[CIRCULAR_BUFFER_MAX_SIZE];
+#endif
+    size_t head;               // Free-running, masked on access
+    size_t tail;
+    uint32_t overflow_count;   // Accumulates over time
+} circular_buffer_pow2_ctx;
+
+/**
+ * @brief Initializes an instance of the power-of-two buffer.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param buff_size The size of the buffer to instantiate. Must be a power of two
+ *                  and less than or equal to MAX_BUFFER_SIZE.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_pow2_init(circular_buffer_pow2_ctx *ctx, size_t buff_size);
+
+/**
+ * @brief Initializes an instance of the power-of-two buffer over caller-provided storage.
+ * See circular_buffer_init_with_storage().
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param mem The storage to use. Must stay valid for the life of the buffer.
+ * @param len The size of mem in bytes, which becomes the size of the buffer. Must be a power of two.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_pow2_init_with_storage(circular_buffer_pow2_ctx *ctx, uint8_t *mem, size_t len);
+
+/**
+ * @brief Adds an item to the buffer.
+ * Will overwrite the oldest data in buffer if full on push.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A piece of data to push.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_pow2_push_with_overwrite(circular_buffer_pow2_ctx *ctx, uint8_t data);
+
+/**
+ * @brief Adds an item to the buffer.
+ * Never overwrites data in buffer. Fails if buffer is full.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A piece of data to push.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_pow2_push_no_overwrite(circular_buffer_pow2_ctx *ctx, uint8_t data);
+
+/**
+ * @brief Removes an item from the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A pointer to return popped data.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_pow2_pop(circular_buffer_pow2_ctx *ctx, uint8_t *data);
+
+/**
+ * @brief Allows peeking at the next item without popping it.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A pointer to return peeked data.
+ *
+ * @return true on success.
+ */
+bool circular_buffer_pow2_peek(const circular_buffer_pow2_ctx *ctx, uint8_t *data);
+
+/**
+ * @brief Use to check if there is anything in the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is empty or if the ctx is NULL, false if there
+ *          are items in the buffer.
+ */
+bool circular_buffer_pow2_is_empty(const circular_buffer_pow2_ctx *ctx);
+
+/**
+ * @brief Use to check if the buffer is full.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is full and false if it is not full.
+ */
+bool circular_buffer_pow2_is_full(const circular_buffer_pow2_ctx *ctx);
+
+/**
+ * @brief Use to retrieve the amount of free space in the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param capacity A way to return the current free capacity in bytes.
+ *
+ * @return true on success, false otherwise.
+ */
+bool circular_buffer_pow2_get_current_capacity(const circular_buffer_pow2_ctx *ctx, size_t *capacity);
+
+/**
+ * @brief Retrieve the number of bytes that have been overwritten due to overflow.
+ *
+ * @param ctx A handle for the buffer.
+ * @param overflow_count A pointer to a place where the retrieved overflow count should be stored.
+ *
+ * @return true if the data was successfully retrieved. false otherwise.
+ */
+bool circular_buffer_pow2_get_overflow_count(const circular_buffer_pow2_ctx *ctx, uint32_t *overflow_count);
+
+/**
+ * @brief Reset the overflow count for this buffer.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the reset was successful. false otherwise.
+ */
+bool circular_buffer_pow2_clear_overflow_count(circular_buffer_pow2_ctx *ctx);
+
+#endif /* _CIRCULAR_BUFFER_POW2_H */
@@ -0,0 +1,199 @@
+#include <string.h>
+
+#include "circular_buffer_record.h"
+
+// Defensive check: indices are in records and should always stay within the buffer,
+// but we verify to guard against potential corruption/misuse.
+static bool ctx_is_valid(const circular_buffer_record_ctx *ctx) {
+    return ctx &&
+           ctx->buffer &&
+           ctx->elem_size > 0 &&
+           ctx->elem_count > 0 &&
+           ctx->elem_count <= SIZE_MAX / ctx->elem_size &&
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+           (ctx->buffer != ctx->storage || ctx->elem_count <= CIRCULAR_BUFFER_MAX_SIZE / ctx->elem_size) &&
+#endif
+           ctx->head < ctx->elem_count &&
+           ctx->tail < ctx->elem_count &&
+           ctx->current_elem_count <= ctx->elem_count;
+}
+
+static size_t next_index(const circular_buffer_record_ctx *ctx, size_t index)
+{
+    index++;
+    return (index == ctx->elem_count) ? 0 : index;
+}
+
+// Records never straddle the end of storage, so each one is a single copy.
+static uint8_t *record_at(const circular_buffer_record_ctx *ctx, size_t index)
+{
+    return &ctx->buffer[index * ctx->elem_size];
+}
+
+bool circular_buffer_record_init(circular_buffer_record_ctx *ctx, size_t elem_size, size_t elem_count)
+{
+    bool res = false;
+
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    if (ctx && 0 < elem_size && elem_count <= CIRCULAR_BUFFER_MAX_SIZE / elem_size)
+    {
+        res = circular_buffer_record_init_with_storage(ctx, elem_size, ctx->storage, elem_size * elem_count);
+    }
+#else
+    (void)ctx;
+    (void)elem_size;
+    (void)elem_count;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_record_init_with_storage(circular_buffer_record_ctx *ctx, size_t elem_size, uint8_t *mem, size_t len)
+{
+    bool res = false;
+
+    if (ctx && mem && 0 < elem_size && elem_size <= len)
+    {
+        ctx->elem_size = elem_size;
+        ctx->elem_count = len / elem_size;
+        ctx->buffer = mem;
+        ctx->head = 0;
+        ctx->tail = 0;
+        ctx->current_elem_count = 0;
+        ctx->overflow_count = 0;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_push_with_overwrite(circular_buffer_record_ctx *ctx, const void *elem)
+{
+    bool res = false;
+
+    if (elem && ctx_is_valid(ctx))
+    {
+        // Buffer is full if true, overwrite mode. Drop the whole oldest record.
+        if (ctx->current_elem_count == ctx->elem_count)
+        {
+            ctx->tail = next_index(ctx, ctx->tail);
+            ctx->current_elem_count--;
+            ctx->overflow_count++;
+        }
+
+        memcpy(record_at(ctx, ctx->head), elem, ctx->elem_size);
+        ctx->head = next_index(ctx, ctx->head);
+        ctx->current_elem_count++;
+
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_push_no_overwrite(circular_buffer_record_ctx *ctx, const void *elem)
+{
+    bool res = false;
+
+    if (elem && ctx_is_valid(ctx) && ctx->current_elem_count < ctx->elem_count)
+    {
+        memcpy(record_at(ctx, ctx->head), elem, ctx->elem_size);
+        ctx->head = next_index(ctx, ctx->head);
+        ctx->current_elem_count++;
+
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_pop(circular_buffer_record_ctx *ctx, void *elem)
+{
+    bool res = false;
+
+    if (elem && ctx_is_valid(ctx) && ctx->current_elem_count > 0)
+    {
+        memcpy(elem, record_at(ctx, ctx->tail), ctx->elem_size);
+        ctx->tail = next_index(ctx, ctx->tail);
+        ctx->current_elem_count--;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_peek(const circular_buffer_record_ctx *ctx, void *elem)
+{
+    bool res = false;
+
+    if (elem && ctx_is_valid(ctx) && ctx->current_elem_count > 0)
+    {
+        memcpy(elem, record_at(ctx, ctx->tail), ctx->elem_size);
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_is_empty(const circular_buffer_record_ctx *ctx)
+{
+    bool res = true; // Consider a NULL ctx to be an empty buffer.
+
+    if (ctx_is_valid(ctx) && ctx->current_elem_count > 0)
+    {
+        res = false;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_is_full(const circular_buffer_record_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && ctx->current_elem_count == ctx->elem_count)
+    {
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_get_current_capacity(const circular_buffer_record_ctx *ctx, size_t *capacity)
+{
+    bool res = false;
+
+    if (capacity && ctx_is_valid(ctx))
+    {
+        *capacity = ctx->elem_count - ctx->current_elem_count;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_get_overflow_count(const circular_buffer_record_ctx *ctx, uint32_t *overflow_count)
+{
+    bool res = false;
+
+    if (overflow_count && ctx_is_valid(ctx))
+    {
+        *overflow_count = ctx->overflow_count;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_record_clear_overflow_count(circular_buffer_record_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx))
+    {
+        ctx->overflow_count = 0;
+        res = true;
+    }
+
+    return res;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file circular_buffer_record.h
+ * @brief A circular buffer of fixed-size records (CAN frames, sensor samples, log entries)
+ * rather than single bytes.
+ *
+ * Every push and pop moves one whole record with a single copy, so a record is never
+ * split or left half written. In overwrite mode the oldest whole record is dropped,
+ * and the overflow count counts records, not bytes.
+ *
+ * @note Not thread-safe, same as circular_buffer.h.
+ */
+#ifndef _CIRCULAR_BUFFER_RECORD_H
+#define _CIRCULAR_BUFFER_RECORD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+
+typedef struct {
+    size_t elem_size;          // Bytes per record
+    size_t elem_count;         // Capacity in records
+    uint8_t *buffer;           // Points at the embedded storage or the caller's memory
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    uint8_t storage[CIRCULAR_BUFFER_MAX_SIZE];
+#endif
+    size_t head;               // Record index
+    size_t tail;               // Record index
+    size_t current_elem_count;
+    uint32_t overflow_count;   // Records overwritten, accumulates over time
+} circular_buffer_record_ctx;
+
+/**
+ * @brief Initializes an instance of the record buffer using the embedded storage.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param elem_size The size of one record in bytes.
+ * @param elem_count The number of records the buffer holds.
+ *                   elem_size * elem_count must be less than or equal to MAX_BUFFER_SIZE.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_record_init(circular_buffer_record_ctx *ctx, size_t elem_size, size_t elem_count);
+
+/**
+ * @brief Initializes an instance of the record buffer over caller-provided storage.
+ * See circular_buffer_init_with_storage().
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param elem_size The size of one record in bytes.
+ * @param mem The storage to use. Must stay valid for the life of the buffer.
+ * @param len The size of mem in bytes. The buffer holds len / elem_size records.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_record_init_with_storage(circular_buffer_record_ctx *ctx, size_t elem_size, uint8_t *mem, size_t len);
+
+/**
+ * @brief Adds a record to the buffer.
+ * Will overwrite the oldest record in buffer if full on push.
+ *
+ * @param ctx A handle for the buffer.
+ * @param elem The record to push. elem_size bytes are copied.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_record_push_with_overwrite(circular_buffer_record_ctx *ctx, const void *elem);
+
+/**
+ * @brief Adds a record to the buffer.
+ * Never overwrites data in buffer. Fails if buffer is full.
+ *
+ * @param ctx A handle for the buffer.
+ * @param elem The record to push. elem_size bytes are copied.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_record_push_no_overwrite(circular_buffer_record_ctx *ctx, const void *elem);
+
+/**
+ * @brief Removes the oldest record from the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param elem A place to return the popped record. Must hold elem_size bytes.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_record_pop(circular_buffer_record_ctx *ctx, void *elem);
+
+/**
+ * @brief Allows peeking at the oldest record without popping it.
+ *
+ * @param ctx A handle for the buffer.
+ * @param elem A place to return the peeked record. Must hold elem_size bytes.
+ *
+ * @return true on success.
+ */
+bool circular_buffer_record_peek(const circular_buffer_record_ctx *ctx, void *elem);
+
+/**
+ * @brief Use to check if there is anything in the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is empty or if the ctx is NULL, false if there
+ *          are records in the buffer.
+ */
+bool circular_buffer_record_is_empty(const circular_buffer_record_ctx *ctx);
+
+/**
+ * @brief Use to check if the buffer is full.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is full and false if it is not full.
+ */
+bool circular_buffer_record_is_full(const circular_buffer_record_ctx *ctx);
+
+/**
+ * @brief Use to retrieve the amount of free space in the buffer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param capacity A way to return the current free capacity in records.
+ *
+ * @return true on success, false otherwise.
+ */
+bool circular_buffer_record_get_current_capacity(const circular_buffer_record_ctx *ctx, size_t *capacity);
+
+/**
+ * @brief Retrieve the number of records that have been overwritten due to overflow.
+ *
+ * @param ctx A handle for the buffer.
+ * @param overflow_count A pointer to a place where the retrieved overflow count should be stored.
+ *
+ * @return true if the data was successfully retrieved. false otherwise.
+ */
+bool circular_buffer_record_get_overflow_count(const circular_buffer_record_ctx *ctx, uint32_t *overflow_count);
+
+/**
+ * @brief Reset the overflow count for this buffer.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the reset was successful. false otherwise.
+ */
+bool circular_buffer_record_clear_overflow_count(circular_buffer_record_ctx *ctx);
+
+#endif /* _CIRCULAR_BUFFER_RECORD_H */
@@ -0,0 +1,156 @@
+#include "circular_buffer_sharded.h"
+
+// Every shard is a plain SPSC buffer, so all the memory ordering lives in circular_buffer_spsc.c.
+// The only state added here, next_shard, is owned by the consumer, so producers must not read it.
+
+static bool ctx_is_valid(const circular_buffer_sharded_ctx *ctx) {
+    return ctx &&
+           ctx->shards &&
+           ctx->shard_count > 0;
+}
+
+// The shard with the most bytes stored, or shard_count if all are empty.
+static size_t fullest_shard(const circular_buffer_sharded_ctx *ctx)
+{
+    size_t fullest = ctx->shard_count;
+    size_t most = 0;
+
+    for (size_t i = 0; i < ctx->shard_count; i++)
+    {
+        size_t capacity = 0;
+
+        if (circular_buffer_spsc_get_current_capacity(&ctx->shards[i], &capacity) &&
+            ctx->shards[i].buff_size - capacity > most)
+        {
+            most = ctx->shards[i].buff_size - capacity;
+            fullest = i;
+        }
+    }
+
+    return fullest;
+}
+
+bool circular_buffer_sharded_init_with_storage(circular_buffer_sharded_ctx *ctx, circular_buffer_spsc_ctx *shards,
+                                               size_t shard_count, uint8_t *mem, size_t len,
+                                               circular_buffer_sharded_policy policy)
+{
+    bool res = false;
+
+    if (ctx && shards && mem && shard_count > 0 &&
+        (policy == CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN || policy == CIRCULAR_BUFFER_SHARDED_FULLEST_FIRST))
+    {
+#if CIRCULAR_BUFFER_CACHE_LINE_SIZE > 0
+        // Start the first shard on a line boundary and keep every shard a whole number of lines,
+        // so every shard starts on one too.
+        size_t offset = (CIRCULAR_BUFFER_CACHE_LINE_SIZE - (uintptr_t)mem % CIRCULAR_BUFFER_CACHE_LINE_SIZE) %
+                        CIRCULAR_BUFFER_CACHE_LINE_SIZE;
+        size_t shard_size = (len > offset) ? (len - offset) / shard_count : 0;
+
+        shard_size -= shard_size % CIRCULAR_BUFFER_CACHE_LINE_SIZE;
+        mem += offset;
+#else
+        size_t shard_size = len / shard_count;
+#endif
+
+        res = (shard_size > 0);
+        for (size_t i = 0; res && i < shard_count; i++)
+        {
+            res = circular_buffer_spsc_init_with_storage(&shards[i], mem + (i * shard_size), shard_size);
+        }
+
+        if (res)
+        {
+            ctx->shards = shards;
+            ctx->shard_count = shard_count;
+            ctx->policy = policy;
+            ctx->next_shard = 0;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_sharded_push(circular_buffer_sharded_ctx *ctx, size_t shard, uint8_t data)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && shard < ctx->shard_count)
+    {
+        res = circular_buffer_spsc_push(&ctx->shards[shard], data);
+    }
+
+    return res;
+}
+
+bool circular_buffer_sharded_write(circular_buffer_sharded_ctx *ctx, size_t shard, const uint8_t *src, size_t len)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && shard < ctx->shard_count)
+    {
+        res = circular_buffer_spsc_write(&ctx->shards[shard], src, len);
+    }
+
+    return res;
+}
+
+bool circular_buffer_sharded_read(circular_buffer_sharded_ctx *ctx, uint8_t *dst, size_t len,
+                                  size_t *read_len, size_t *shard)
+{
+    bool res = false;
+
+    if (dst && read_len && ctx_is_valid(ctx) && ctx->next_shard < ctx->shard_count)
+    {
+        *read_len = 0;
+
+        if (ctx->policy == CIRCULAR_BUFFER_SHARDED_FULLEST_FIRST)
+        {
+            size_t fullest = fullest_shard(ctx);
+
+            if (fullest < ctx->shard_count)
+            {
+                // Only the consumer removes bytes, so the shard still holds at least as many as counted.
+                res = circular_buffer_spsc_read(&ctx->shards[fullest], dst, len, read_len);
+                if (res && shard)
+                {
+                    *shard = fullest;
+                }
+            }
+        }
+        else
+        {
+            for (size_t i = 0; !res && i < ctx->shard_count; i++)
+            {
+                size_t candidate = (ctx->next_shard + i) % ctx->shard_count;
+
+                if (circular_buffer_spsc_read(&ctx->shards[candidate], dst, len, read_len))
+                {
+                    // Start after this shard next time, so a busy shard cannot starve the others.
+                    ctx->next_shard = (candidate + 1) % ctx->shard_count;
+                    if (shard)
+                    {
+                        *shard = candidate;
+                    }
+                    res = true;
+                }
+            }
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_sharded_is_empty(const circular_buffer_sharded_ctx *ctx)
+{
+    bool res = true; // Consider a NULL ctx to be an empty buffer.
+
+    if (ctx_is_valid(ctx))
+    {
+        for (size_t i = 0; res && i < ctx->shard_count; i++)
+        {
+            res = circular_buffer_spsc_is_empty(&ctx->shards[i]);
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file circular_buffer_sharded.h
+ * @brief Many producers feeding one consumer through one SPSC buffer per producer.
+ *
+ * Each producer (typically one per core) owns a shard and writes to it with no atomics
+ * shared with any other producer, so producers never contend with each other. The consumer
+ * drains the shards through one merged view, a whole batch from one shard at a time, so
+ * bytes from a shard stay in order and the consumer always knows where a batch came from.
+ *
+ * @note Each shard must have exactly one producer, and there must be exactly one consumer.
+ * Init is not thread-safe and must finish before any producer or the consumer starts.
+ */
+#ifndef _CIRCULAR_BUFFER_SHARDED_H
+#define _CIRCULAR_BUFFER_SHARDED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer_spsc.h"
+
+typedef enum {
+    CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN,     // Visit the shards in turn, starting after the last one read
+    CIRCULAR_BUFFER_SHARDED_FULLEST_FIRST,   // Read the shard holding the most bytes, to relieve the busiest producer
+} circular_buffer_sharded_policy;
+
+typedef struct {
+    circular_buffer_spsc_ctx *shards;     // Caller's array, one shard per producer
+    size_t shard_count;
+    circular_buffer_sharded_policy policy;
+    size_t next_shard;                    // Consumer-owned round robin position
+} circular_buffer_sharded_ctx;
+
+/**
+ * @brief Initializes a sharded buffer, splitting mem evenly between the shards.
+ * With CIRCULAR_BUFFER_CACHE_LINE_SIZE set, the first shard starts at the first line boundary
+ * in mem and each shard's storage is rounded down to a whole number of cache lines, so every
+ * shard starts on a line boundary and neighbouring shards never share one. mem need not be aligned.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param shards The caller's array of shard_count blank SPSC handles. Must stay valid for the life of the buffer.
+ * @param shard_count The number of shards, normally the number of producers.
+ * @param mem The storage for all shards. Must stay valid for the life of the buffer.
+ * @param len The size of mem in bytes. Must leave every shard at least one byte, or with
+ *            CIRCULAR_BUFFER_CACHE_LINE_SIZE set at least one whole line after the alignment skip.
+ * @param policy The order in which circular_buffer_sharded_read() visits the shards.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_sharded_init_with_storage(circular_buffer_sharded_ctx *ctx, circular_buffer_spsc_ctx *shards,
+                                               size_t shard_count, uint8_t *mem, size_t len,
+                                               circular_buffer_sharded_policy policy);
+
+/**
+ * @brief Adds an item to a shard. Only the shard's producer may call this.
+ * Never overwrites data in buffer. Fails if the shard is full.
+ *
+ * @param ctx A handle for the buffer.
+ * @param shard The producer's shard index.
+ * @param data A piece of data to push.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_sharded_push(circular_buffer_sharded_ctx *ctx, size_t shard, uint8_t data);
+
+/**
+ * @brief Adds a block of bytes to a shard. Only the shard's producer may call this.
+ * All or nothing, see circular_buffer_spsc_write(). The consumer sees the whole block at once.
+ *
+ * @param ctx A handle for the buffer.
+ * @param shard The producer's shard index.
+ * @param src The bytes to add.
+ * @param len The number of bytes to add.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_sharded_write(circular_buffer_sharded_ctx *ctx, size_t shard, const uint8_t *src, size_t len);
+
+/**
+ * @brief Removes up to len bytes from one shard, picked by the policy. Consumer side only.
+ * Shards that turn out to be empty are skipped, so one call finds data if any shard has some.
+ *
+ * @param ctx A handle for the buffer.
+ * @param dst Where to copy the bytes.
+ * @param len The most bytes to remove.
+ * @param read_len A pointer to return the number of bytes removed.
+ * @param shard A pointer to return the index of the shard they came from. May be NULL.
+ *
+ * @return true if at least one byte was removed, false if all shards are empty or on invalid arguments.
+*/
+bool circular_buffer_sharded_read(circular_buffer_sharded_ctx *ctx, uint8_t *dst, size_t len,
+                                  size_t *read_len, size_t *shard);
+
+/**
+ * @brief Use to check if there is anything in any shard.
+ * Exact for the consumer, may already be stale for a producer.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if every shard is empty or if the ctx is NULL.
+ */
+bool circular_buffer_sharded_is_empty(const circular_buffer_sharded_ctx *ctx);
+
+#endif /* _CIRCULAR_BUFFER_SHARDED_H */
@@ -0,0 +1,299 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "circular_buffer_shm.h"
+
+// Same index scheme as circular_buffer_spsc.c, in 32 bits: head and tail run over
+// [0, 2 * buff_size) so full and empty differ without a shared counter.
+//
+// Atomics shared between processes must be lock-free, otherwise they may be implemented
+// with a lock that lives in one process's memory.
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "32-bit atomics must be lock-free to be shared between processes");
+
+static bool ctx_is_valid(const circular_buffer_shm_ctx *ctx) {
+    return ctx &&
+           ctx->region &&
+           ctx->storage &&
+           ctx->buff_size > 0 &&
+           ctx->buff_size <= UINT32_MAX / 4;
+}
+
+static uint32_t byte_count(const circular_buffer_shm_ctx *ctx, uint32_t head, uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + (2 * ctx->buff_size) - tail);
+}
+
+// Defensive check on a pair of indices loaded from the region, which another process could have corrupted.
+static bool indices_are_valid(const circular_buffer_shm_ctx *ctx, uint32_t head, uint32_t tail)
+{
+    return head < 2 * ctx->buff_size &&
+           tail < 2 * ctx->buff_size &&
+           byte_count(ctx, head, tail) <= ctx->buff_size;
+}
+
+static uint32_t storage_position(const circular_buffer_shm_ctx *ctx, uint32_t index)
+{
+    return (index >= ctx->buff_size) ? (index - ctx->buff_size) : index;
+}
+
+// Moves an index forward by len, which is at most buff_size. The sum stays below 3 * buff_size,
+// which fits in 32 bits because buff_size is at most UINT32_MAX / 4.
+static uint32_t advance_index(const circular_buffer_shm_ctx *ctx, uint32_t index, uint32_t len)
+{
+    index += len;
+    return (index >= 2 * ctx->buff_size) ? (index - 2 * ctx->buff_size) : index;
+}
+
+// Fills in the process-local half of the ctx from a mapped, checked region.
+static void bind(circular_buffer_shm_ctx *ctx, uint8_t *mapping, size_t map_size, uint32_t buff_size)
+{
+    ctx->region = (circular_buffer_shm_region *)mapping;
+    ctx->storage = mapping + sizeof(circular_buffer_shm_region);
+    ctx->map_size = map_size;
+    ctx->buff_size = buff_size;
+    ctx->cached_head = atomic_load_explicit(&ctx->region->head, memory_order_acquire);
+    ctx->cached_tail = atomic_load_explicit(&ctx->region->tail, memory_order_acquire);
+}
+
+bool circular_buffer_shm_create(circular_buffer_shm_ctx *ctx, const char *name, size_t buff_size)
+{
+    bool res = false;
+
+    if (ctx && name && 0 < buff_size && buff_size <= UINT32_MAX / 4)
+    {
+        size_t map_size = sizeof(circular_buffer_shm_region) + buff_size;
+        uint8_t *mapping = MAP_FAILED;
+        int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+
+        ctx->region = NULL;
+
+        if (fd >= 0)
+        {
+            // Zero filled, so state reads 0 until the header is complete.
+            if (ftruncate(fd, (off_t)map_size) == 0)
+            {
+                mapping = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            // The mapping keeps the object alive.
+            (void)close(fd);
+
+            if (mapping == MAP_FAILED)
+            {
+                // Do not leave a half-made object behind for attachers to find.
+                int saved_errno = errno;
+                (void)shm_unlink(name);
+                errno = saved_errno;
+            }
+        }
+
+        if (mapping != MAP_FAILED)
+        {
+            circular_buffer_shm_region *region = (circular_buffer_shm_region *)mapping;
+
+            region->magic = CIRCULAR_BUFFER_SHM_MAGIC;
+            region->version = CIRCULAR_BUFFER_SHM_VERSION;
+            region->header_size = sizeof(circular_buffer_shm_region);
+            region->buff_size = (uint32_t)buff_size;
+            atomic_init(&region->head, 0);
+            atomic_init(&region->tail, 0);
+            // Release publishes the header to an attacher that acquires state.
+            atomic_store_explicit(&region->state, CIRCULAR_BUFFER_SHM_READY, memory_order_release);
+
+            bind(ctx, mapping, map_size, (uint32_t)buff_size);
+            res = true;
+        }
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+    return res;
+}
+
+bool circular_buffer_shm_attach(circular_buffer_shm_ctx *ctx, const char *name)
+{
+    bool res = false;
+
+    if (ctx && name)
+    {
+        struct stat shm_stat;
+        size_t map_size = 0;
+        uint8_t *mapping = MAP_FAILED;
+        int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+
+        ctx->region = NULL;
+
+        if (fd >= 0)
+        {
+            if (fstat(fd, &shm_stat) == 0)
+            {
+                // Until the creator's ftruncate() the object is empty.
+                if ((size_t)shm_stat.st_size > sizeof(circular_buffer_shm_region))
+                {
+                    map_size = (size_t)shm_stat.st_size;
+                    mapping = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                }
+                else
+                {
+                    errno = EAGAIN;
+                }
+            }
+            (void)close(fd);
+        }
+
+        if (mapping != MAP_FAILED)
+        {
+            circular_buffer_shm_region *region = (circular_buffer_shm_region *)mapping;
+
+            // Acquire pairs with the creator's release, so the header below is complete.
+            if (atomic_load_explicit(&region->state, memory_order_acquire) != CIRCULAR_BUFFER_SHM_READY)
+            {
+                errno = EAGAIN;
+            }
+            else if (region->magic != CIRCULAR_BUFFER_SHM_MAGIC ||
+                     region->version != CIRCULAR_BUFFER_SHM_VERSION ||
+                     region->header_size != sizeof(circular_buffer_shm_region) ||
+                     region->buff_size == 0 ||
+                     region->buff_size > UINT32_MAX / 4 ||
+                     region->buff_size != map_size - sizeof(circular_buffer_shm_region))
+            {
+                errno = EINVAL;
+            }
+            else
+            {
+                bind(ctx, mapping, map_size, region->buff_size);
+                res = true;
+            }
+
+            if (!res)
+            {
+                (void)munmap(mapping, map_size);
+            }
+        }
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+    return res;
+}
+
+bool circular_buffer_shm_detach(circular_buffer_shm_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx) && munmap(ctx->region, ctx->map_size) == 0)
+    {
+        ctx->region = NULL;
+        ctx->storage = NULL;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_shm_push(circular_buffer_shm_ctx *ctx, uint8_t data)
+{
+    return circular_buffer_shm_write(ctx, &data, 1);
+}
+
+bool circular_buffer_shm_write(circular_buffer_shm_ctx *ctx, const uint8_t *src, size_t len)
+{
+    bool res = false;
+
+    if (src && ctx_is_valid(ctx) && len <= ctx->buff_size)
+    {
+        uint32_t head = atomic_load_explicit(&ctx->region->head, memory_order_relaxed);
+        uint32_t tail = ctx->cached_tail;
+
+        if (!indices_are_valid(ctx, head, tail) || ctx->buff_size - byte_count(ctx, head, tail) < len)
+        {
+            // Looks too full, or the cached view is from before a corruption. Acquire on tail so the consumer's reads of the slots finish before we reuse them.
+            tail = atomic_load_explicit(&ctx->region->tail, memory_order_acquire);
+            ctx->cached_tail = tail;
+        }
+
+        if (indices_are_valid(ctx, head, tail) && ctx->buff_size - byte_count(ctx, head, tail) >= len)
+        {
+            uint32_t start = storage_position(ctx, head);
+            size_t first_len = (ctx->buff_size - start < len) ? (ctx->buff_size - start) : len;
+
+            memcpy(&ctx->storage[start], src, first_len);
+            memcpy(&ctx->storage[0], src + first_len, len - first_len);
+            // Release publishes the block before the new head becomes visible.
+            atomic_store_explicit(&ctx->region->head, advance_index(ctx, head, (uint32_t)len), memory_order_release);
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_shm_pop(circular_buffer_shm_ctx *ctx, uint8_t *data)
+{
+    size_t read_len = 0;
+
+    return circular_buffer_shm_read(ctx, data, 1, &read_len);
+}
+
+bool circular_buffer_shm_read(circular_buffer_shm_ctx *ctx, uint8_t *dst, size_t len, size_t *read_len)
+{
+    bool res = false;
+
+    if (dst && read_len && ctx_is_valid(ctx))
+    {
+        uint32_t tail = atomic_load_explicit(&ctx->region->tail, memory_order_relaxed);
+        uint32_t head = ctx->cached_head;
+
+        *read_len = 0;
+
+        if (!indices_are_valid(ctx, head, tail) || byte_count(ctx, head, tail) < len)
+        {
+            // Fewer bytes than asked for as far as we know, or the cached view is from before a corruption. Acquire on head pairs with the producer's release.
+            head = atomic_load_explicit(&ctx->region->head, memory_order_acquire);
+            ctx->cached_head = head;
+        }
+
+        if (indices_are_valid(ctx, head, tail) && head != tail && len > 0)
+        {
+            uint32_t count = byte_count(ctx, head, tail);
+            size_t n = (count < len) ? count : len;
+            uint32_t start = storage_position(ctx, tail);
+            size_t first_len = (ctx->buff_size - start < n) ? (ctx->buff_size - start) : n;
+
+            memcpy(dst, &ctx->storage[start], first_len);
+            memcpy(dst + first_len, &ctx->storage[0], n - first_len);
+            // Release hands the slots back only after the bytes have been read.
+            atomic_store_explicit(&ctx->region->tail, advance_index(ctx, tail, (uint32_t)n), memory_order_release);
+            *read_len = n;
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_shm_is_empty(const circular_buffer_shm_ctx *ctx)
+{
+    bool res = true; // Consider a NULL ctx to be an empty buffer.
+
+    if (ctx_is_valid(ctx))
+    {
+        uint32_t tail = atomic_load_explicit(&ctx->region->tail, memory_order_acquire);
+        uint32_t head = atomic_load_explicit(&ctx->region->head, memory_order_acquire);
+
+        if (indices_are_valid(ctx, head, tail) && head != tail)
+        {
+            res = false;
+        }
+    }
+
+    return res;
+}
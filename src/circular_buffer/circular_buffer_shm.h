@@ -0,0 +1,148 @@
+/**
+ * @file circular_buffer_shm.h
+ * @brief A lock-free single-producer/single-consumer byte buffer in POSIX shared memory,
+ * for moving data between processes without a kernel copy.
+ *
+ * The shared region (circular_buffer_shm_region, then the storage) holds only fixed-width
+ * integers and offsets, never pointers, so each process can map it at a different address.
+ * Head and tail are lock-free 32-bit atomics, which are address-free and therefore work across
+ * processes the same way they work across threads. The algorithm is the one in
+ * circular_buffer_spsc.h: the producer owns head, the consumer owns tail, and each side keeps a
+ * cached copy of the other's index in its own process-local circular_buffer_shm_ctx.
+ *
+ * One process creates the region and the other attaches to it. The creator fills in the header
+ * and publishes it by setting state to READY last, and the attacher checks the state, magic,
+ * version and layout before touching the data, so a half-initialized region or one written by
+ * an incompatible build is never used.
+ *
+ * @note Linux only. Built when CIRCULAR_BUFFER_LINUX_EXTENSIONS is on. Exactly one process may
+ * push or write and exactly one may pop or read. The shared indices are validated against the
+ * size read at attach time on every call, so a corrupted region makes calls fail instead of
+ * reading or writing out of bounds.
+ */
+#ifndef _CIRCULAR_BUFFER_SHM_H
+#define _CIRCULAR_BUFFER_SHM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer_atomic.h"
+
+#define CIRCULAR_BUFFER_SHM_MAGIC   0x4D485343u  // "CSHM" in a little-endian region
+#define CIRCULAR_BUFFER_SHM_VERSION 1u
+#define CIRCULAR_BUFFER_SHM_READY   1u           // state once the creator has finished the header
+
+// The start of the shared region. The storage follows at offset header_size.
+typedef struct {
+    uint32_t magic;            // CIRCULAR_BUFFER_SHM_MAGIC
+    uint32_t version;          // CIRCULAR_BUFFER_SHM_VERSION
+    uint32_t header_size;      // sizeof(circular_buffer_shm_region), differs between cache line layouts
+    uint32_t buff_size;
+    CIRCULAR_BUFFER_ATOMIC(uint32_t) state;  // 0 while the creator initializes, then CIRCULAR_BUFFER_SHM_READY
+
+    // Producer-owned line.
+    CIRCULAR_BUFFER_CACHE_ALIGNED CIRCULAR_BUFFER_ATOMIC(uint32_t) head;  // Runs over [0, 2 * buff_size)
+
+    // Consumer-owned line.
+    CIRCULAR_BUFFER_CACHE_ALIGNED CIRCULAR_BUFFER_ATOMIC(uint32_t) tail;  // Runs over [0, 2 * buff_size)
+} circular_buffer_shm_region;
+
+// Process-local handle. Never placed in shared memory.
+typedef struct {
+    circular_buffer_shm_region *region;  // This process's mapping of the region
+    uint8_t *storage;                    // This process's address of the storage
+    size_t map_size;
+    uint32_t buff_size;                  // Copied at attach time, the shared copy is not trusted afterwards
+    uint32_t cached_head;                // The consumer's last view of head
+    uint32_t cached_tail;                // The producer's last view of tail
+} circular_buffer_shm_ctx;
+
+/**
+ * @brief Creates the shared memory object name and initializes an empty buffer in it.
+ * Fails if the object already exists. Remove it with shm_unlink() when done.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param name The shared memory object name, "/something", see shm_open(3).
+ * @param buff_size The size of the buffer in bytes. At most UINT32_MAX / 4.
+ * @return true if success. false with errno set otherwise: EINVAL on invalid arguments, or the
+ *         error from shm_open(), ftruncate() or mmap().
+*/
+bool circular_buffer_shm_create(circular_buffer_shm_ctx *ctx, const char *name, size_t buff_size);
+
+/**
+ * @brief Attaches to a buffer created by circular_buffer_shm_create(), usually in another process.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param name The name given to circular_buffer_shm_create().
+ * @return true if success. false with errno set otherwise: EAGAIN if the creator has not
+ *         finished initializing it yet, EINVAL if it is not a buffer of this version and layout,
+ *         or the error from shm_open() or mmap().
+*/
+bool circular_buffer_shm_attach(circular_buffer_shm_ctx *ctx, const char *name);
+
+/**
+ * @brief Unmaps the region from this process. The buffer lives on while any process has it
+ * mapped or until the name is unlinked.
+ *
+ * @param ctx A handle for the buffer.
+ * @return true if success.
+*/
+bool circular_buffer_shm_detach(circular_buffer_shm_ctx *ctx);
+
+/**
+ * @brief Adds an item to the buffer. Producer side only.
+ * Never overwrites data in buffer. Fails if buffer is full.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A piece of data to push.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_shm_push(circular_buffer_shm_ctx *ctx, uint8_t data);
+
+/**
+ * @brief Adds a block of bytes to the buffer in one step. Producer side only.
+ * All or nothing: fails without writing anything if len bytes do not fit.
+ *
+ * @param ctx A handle for the buffer.
+ * @param src The bytes to add.
+ * @param len The number of bytes to add.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_shm_write(circular_buffer_shm_ctx *ctx, const uint8_t *src, size_t len);
+
+/**
+ * @brief Removes an item from the buffer. Consumer side only.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A pointer to return popped data.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_shm_pop(circular_buffer_shm_ctx *ctx, uint8_t *data);
+
+/**
+ * @brief Removes up to len of the oldest bytes in one step. Consumer side only.
+ *
+ * @param ctx A handle for the buffer.
+ * @param dst Where to copy the bytes.
+ * @param len The most bytes to remove.
+ * @param read_len A pointer to return the number of bytes removed.
+ *
+ * @return true if at least one byte was removed, false if the buffer is empty or on invalid arguments.
+*/
+bool circular_buffer_shm_read(circular_buffer_shm_ctx *ctx, uint8_t *dst, size_t len, size_t *read_len);
+
+/**
+ * @brief Use to check if there is anything in the buffer.
+ * Exact for the consumer. For the producer it may already be stale when it returns.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is empty or if the ctx is NULL.
+ */
+bool circular_buffer_shm_is_empty(const circular_buffer_shm_ctx *ctx);
+
+#endif /* _CIRCULAR_BUFFER_SHM_H */
@@ -0,0 +1,288 @@
+#include <stdatomic.h>
+#include <string.h>
+
+#include "circular_buffer_spsc.h"
+
+// Head and tail run over [0, 2 * buff_size) so that a full buffer (head - tail == buff_size)
+// can be told apart from an empty one (head == tail) without a shared counter,
+// and without a modulo on every access.
+//
+// The producer checks for space against cached_tail and the consumer checks for data against
+// cached_head. Both are stale in the safe direction, so the shared index is only loaded (and
+// its cache line only pulled across cores) when the buffer appears full or empty.
+
+static bool ctx_is_valid(const circular_buffer_spsc_ctx *ctx) {
+    return ctx &&
+           ctx->buffer &&
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+           (ctx->buffer != ctx->storage || ctx->buff_size <= CIRCULAR_BUFFER_MAX_SIZE) &&
+#endif
+           ctx->buff_size > 0 &&
+           ctx->buff_size <= SIZE_MAX / 2;
+}
+
+static size_t byte_count(const circular_buffer_spsc_ctx *ctx, size_t head, size_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + (2 * ctx->buff_size) - tail);
+}
+
+// Defensive check on a pair of loaded indices, the lock-free counterpart of ctx_is_valid.
+static bool indices_are_valid(const circular_buffer_spsc_ctx *ctx, size_t head, size_t tail)
+{
+    return head < 2 * ctx->buff_size &&
+           tail < 2 * ctx->buff_size &&
+           byte_count(ctx, head, tail) <= ctx->buff_size;
+}
+
+static size_t next_index(const circular_buffer_spsc_ctx *ctx, size_t index)
+{
+    index++;
+    return (index == 2 * ctx->buff_size) ? 0 : index;
+}
+
+static size_t storage_position(const circular_buffer_spsc_ctx *ctx, size_t index)
+{
+    return (index >= ctx->buff_size) ? (index - ctx->buff_size) : index;
+}
+
+// Moves an index forward by len, which is at most buff_size.
+static size_t advance_index(const circular_buffer_spsc_ctx *ctx, size_t index, size_t len)
+{
+    index += len;
+    return (index >= 2 * ctx->buff_size) ? (index - 2 * ctx->buff_size) : index;
+}
+
+bool circular_buffer_spsc_init(circular_buffer_spsc_ctx *ctx, size_t buff_size)
+{
+    bool res = false;
+
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    if (ctx && buff_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        res = circular_buffer_spsc_init_with_storage(ctx, ctx->storage, buff_size);
+    }
+#else
+    (void)ctx;
+    (void)buff_size;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_spsc_init_with_storage(circular_buffer_spsc_ctx *ctx, uint8_t *mem, size_t len)
+{
+    bool res = false;
+
+    // Indices run up to 2 * buff_size, which must not overflow.
+    if (ctx && mem && 0 < len && len <= SIZE_MAX / 2)
+    {
+        ctx->buff_size = len;
+        ctx->buffer = mem;
+        atomic_init(&ctx->head, 0);
+        atomic_init(&ctx->tail, 0);
+        ctx->cached_tail = 0;
+        ctx->cached_head = 0;
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_push(circular_buffer_spsc_ctx *ctx, uint8_t data)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx))
+    {
+        size_t head = atomic_load_explicit(&ctx->head, memory_order_relaxed);
+        size_t tail = ctx->cached_tail;
+
+        if (indices_are_valid(ctx, head, tail) && byte_count(ctx, head, tail) == ctx->buff_size)
+        {
+            // Looks full. Acquire on tail so the consumer's reads of a slot finish before we reuse it.
+            tail = atomic_load_explicit(&ctx->tail, memory_order_acquire);
+            ctx->cached_tail = tail;
+        }
+
+        if (indices_are_valid(ctx, head, tail) && byte_count(ctx, head, tail) < ctx->buff_size)
+        {
+            ctx->buffer[storage_position(ctx, head)] = data;
+            // Release publishes the byte before the new head becomes visible.
+            atomic_store_explicit(&ctx->head, next_index(ctx, head), memory_order_release);
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_write(circular_buffer_spsc_ctx *ctx, const uint8_t *src, size_t len)
+{
+    bool res = false;
+
+    if (src && ctx_is_valid(ctx) && len <= ctx->buff_size)
+    {
+        size_t head = atomic_load_explicit(&ctx->head, memory_order_relaxed);
+        size_t tail = ctx->cached_tail;
+
+        if (indices_are_valid(ctx, head, tail) && ctx->buff_size - byte_count(ctx, head, tail) < len)
+        {
+            // Looks too full. Acquire on tail so the consumer's reads of the slots finish before we reuse them.
+            tail = atomic_load_explicit(&ctx->tail, memory_order_acquire);
+            ctx->cached_tail = tail;
+        }
+
+        if (indices_are_valid(ctx, head, tail) && ctx->buff_size - byte_count(ctx, head, tail) >= len)
+        {
+            size_t start = storage_position(ctx, head);
+            size_t first_len = (ctx->buff_size - start < len) ? (ctx->buff_size - start) : len;
+
+            memcpy(&ctx->buffer[start], src, first_len);
+            memcpy(&ctx->buffer[0], src + first_len, len - first_len);
+            // Release publishes the whole block before the new head becomes visible.
+            atomic_store_explicit(&ctx->head, advance_index(ctx, head, len), memory_order_release);
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_pop(circular_buffer_spsc_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && ctx_is_valid(ctx))
+    {
+        size_t tail = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+        size_t head = ctx->cached_head;
+
+        if (head == tail)
+        {
+            // Looks empty. Acquire on head pairs with the producer's release, making the byte visible.
+            head = atomic_load_explicit(&ctx->head, memory_order_acquire);
+            ctx->cached_head = head;
+        }
+
+        if (indices_are_valid(ctx, head, tail) && head != tail)
+        {
+            *data = ctx->buffer[storage_position(ctx, tail)];
+            // Release hands the slot back only after the byte has been read.
+            atomic_store_explicit(&ctx->tail, next_index(ctx, tail), memory_order_release);
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_read(circular_buffer_spsc_ctx *ctx, uint8_t *dst, size_t len, size_t *read_len)
+{
+    bool res = false;
+
+    if (dst && read_len && ctx_is_valid(ctx))
+    {
+        size_t tail = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+        size_t head = ctx->cached_head;
+
+        *read_len = 0;
+
+        if (indices_are_valid(ctx, head, tail) && byte_count(ctx, head, tail) < len)
+        {
+            // Fewer bytes than asked for as far as we know. Acquire on head pairs with the producer's release.
+            head = atomic_load_explicit(&ctx->head, memory_order_acquire);
+            ctx->cached_head = head;
+        }
+
+        if (indices_are_valid(ctx, head, tail) && head != tail && len > 0)
+        {
+            size_t count = byte_count(ctx, head, tail);
+            size_t n = (count < len) ? count : len;
+            size_t start = storage_position(ctx, tail);
+            size_t first_len = (ctx->buff_size - start < n) ? (ctx->buff_size - start) : n;
+
+            memcpy(dst, &ctx->buffer[start], first_len);
+            memcpy(dst + first_len, &ctx->buffer[0], n - first_len);
+            // Release hands the slots back only after the bytes have been read.
+            atomic_store_explicit(&ctx->tail, advance_index(ctx, tail, n), memory_order_release);
+            *read_len = n;
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_peek(const circular_buffer_spsc_ctx *ctx, uint8_t *data)
+{
+    bool res = false;
+
+    if (data && ctx_is_valid(ctx))
+    {
+        size_t tail = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&ctx->head, memory_order_acquire);
+
+        if (indices_are_valid(ctx, head, tail) && head != tail)
+        {
+            *data = ctx->buffer[storage_position(ctx, tail)];
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_is_empty(const circular_buffer_spsc_ctx *ctx)
+{
+    bool res = true; // Consider a NULL ctx to be an empty buffer.
+
+    if (ctx_is_valid(ctx))
+    {
+        size_t tail = atomic_load_explicit(&ctx->tail, memory_order_acquire);
+        size_t head = atomic_load_explicit(&ctx->head, memory_order_acquire);
+
+        if (indices_are_valid(ctx, head, tail) && head != tail)
+        {
+            res = false;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_is_full(const circular_buffer_spsc_ctx *ctx)
+{
+    bool res = false;
+
+    if (ctx_is_valid(ctx))
+    {
+        size_t head = atomic_load_explicit(&ctx->head, memory_order_acquire);
+        size_t tail = atomic_load_explicit(&ctx->tail, memory_order_acquire);
+
+        if (indices_are_valid(ctx, head, tail) && byte_count(ctx, head, tail) == ctx->buff_size)
+        {
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_spsc_get_current_capacity(const circular_buffer_spsc_ctx *ctx, size_t *capacity)
+{
+    bool res = false;
+
+    if (capacity && ctx_is_valid(ctx))
+    {
+        size_t head = atomic_load_explicit(&ctx->head, memory_order_acquire);
+        size_t tail = atomic_load_explicit(&ctx->tail, memory_order_acquire);
+
+        if (indices_are_valid(ctx, head, tail))
+        {
+            *capacity = ctx->buff_size - byte_count(ctx, head, tail);
+            res = true;
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file circular_buffer_spsc.h
+ * @brief A lock-free single-producer/single-consumer variant of the circular byte buffer.
+ *
+ * @note Safe for exactly one producer and one consumer running concurrently,
+ * e.g. an ISR pushing and a thread popping, without disabling interrupts or locking.
+ * The producer owns head and the consumer owns tail. There is no shared byte counter;
+ * fullness and emptiness are derived from the two indices. Each side keeps a cached copy
+ * of the other side's index and only reloads it when the buffer looks full or empty.
+ * See CIRCULAR_BUFFER_CACHE_LINE_SIZE in circular_buffer_atomic.h for the padded layout.
+ * Init is not thread-safe and must finish before either side starts.
+ */
+#ifndef _CIRCULAR_BUFFER_SPSC_H
+#define _CIRCULAR_BUFFER_SPSC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer.h"
+#include "circular_buffer_atomic.h"
+
+typedef struct {
+    size_t buff_size;                     // Up to MAX_SIZE with embedded storage, any size with caller storage
+    uint8_t *buffer;                      // Points at the embedded storage or the caller's memory
+
+    // Producer-owned line.
+    CIRCULAR_BUFFER_CACHE_ALIGNED CIRCULAR_BUFFER_ATOMIC(size_t) head;  // Written by the producer only, runs over [0, 2 * buff_size)
+    size_t cached_tail;                   // The producer's last view of tail
+
+    // Consumer-owned line.
+    CIRCULAR_BUFFER_CACHE_ALIGNED CIRCULAR_BUFFER_ATOMIC(size_t) tail;  // Written by the consumer only, runs over [0, 2 * buff_size)
+    size_t cached_head;                   // The consumer's last view of head
+
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    CIRCULAR_BUFFER_CACHE_ALIGNED uint8_t storage[CIRCULAR_BUFFER_MAX_SIZE];
+#endif
+} circular_buffer_spsc_ctx;
+
+/**
+ * @brief Initializes an instance of the single-producer/single-consumer buffer.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param buff_size The size of the buffer to instantiate. Must be less than or equal to MAX_BUFFER_SIZE.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_spsc_init(circular_buffer_spsc_ctx *ctx, size_t buff_size);
+
+/**
+ * @brief Initializes an instance of the single-producer/single-consumer buffer over caller-provided storage.
+ * See circular_buffer_init_with_storage().
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param mem The storage to use. Must stay valid for the life of the buffer.
+ * @param len The size of mem in bytes, which becomes the size of the buffer.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_spsc_init_with_storage(circular_buffer_spsc_ctx *ctx, uint8_t *mem, size_t len);
+
+/**
+ * @brief Adds an item to the buffer. Producer side only.
+ * Never overwrites data in buffer. Fails if buffer is full.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A piece of data to push.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_spsc_push(circular_buffer_spsc_ctx *ctx, uint8_t data);
+
+/**
+ * @brief Adds a block of bytes to the buffer in one step. Producer side only.
+ * All or nothing: fails without writing anything if len bytes do not fit.
+ * The consumer sees the whole block at once, never part of it.
+ *
+ * @param ctx A handle for the buffer.
+ * @param src The bytes to add.
+ * @param len The number of bytes to add.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_spsc_write(circular_buffer_spsc_ctx *ctx, const uint8_t *src, size_t len);
+
+/**
+ * @brief Removes an item from the buffer. Consumer side only.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A pointer to return popped data.
+ *
+ * @return true on success.
+*/
+bool circular_buffer_spsc_pop(circular_buffer_spsc_ctx *ctx, uint8_t *data);
+
+/**
+ * @brief Removes up to len of the oldest bytes in one step. Consumer side only.
+ *
+ * @param ctx A handle for the buffer.
+ * @param dst Where to copy the bytes.
+ * @param len The most bytes to remove.
+ * @param read_len A pointer to return the number of bytes removed.
+ *
+ * @return true if at least one byte was removed, false if the buffer is empty or on invalid arguments.
+*/
+bool circular_buffer_spsc_read(circular_buffer_spsc_ctx *ctx, uint8_t *dst, size_t len, size_t *read_len);
+
+/**
+ * @brief Allows peeking at the next item without popping it. Consumer side only.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A pointer to return peeked data.
+ *
+ * @return true on success.
+ */
+bool circular_buffer_spsc_peek(const circular_buffer_spsc_ctx *ctx, uint8_t *data);
+
+/**
+ * @brief Use to check if there is anything in the buffer.
+ * Exact for the consumer. For the producer it may already be stale when it returns.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is empty or if the ctx is NULL, false if there
+ *          are items in the buffer.
+ */
+bool circular_buffer_spsc_is_empty(const circular_buffer_spsc_ctx *ctx);
+
+/**
+ * @brief Use to check if the buffer is full.
+ * Exact for the producer. For the consumer it may already be stale when it returns.
+ *
+ * @param ctx A handle for the buffer.
+ *
+ * @return true if the buffer is full and false if it is not full.
+ */
+bool circular_buffer_spsc_is_full(const circular_buffer_spsc_ctx *ctx);
+
+/**
+ * @brief Use to retrieve the amount of free space in the buffer.
+ * A lower bound for the producer, an upper bound for the consumer.
+ *
+ * @param ctx A handle for the buffer.
+ * @param capacity A way to return the current free capacity in bytes.
+ *
+ * @return true on success, false otherwise.
+ */
+bool circular_buffer_spsc_get_current_capacity(const circular_buffer_spsc_ctx *ctx, size_t *capacity);
+
+#endif /* _CIRCULAR_BUFFER_SPSC_H */
@@ -0,0 +1,217 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <stdatomic.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "circular_buffer_wait.h"
+
+// Lost wakeups are ruled out Dekker style. The waiting side sets its flag, fences, then retries
+// the ring. The other side updates the ring, fences, then checks the flag. With a seq_cst fence
+// on both sides at least one of them sees the other's write: either the retry succeeds or the
+// wake is sent. The futex word is sampled before the flag is raised, so a wake that lands
+// between the retry and the futex_wait makes the kernel return immediately instead of sleeping.
+
+static long futex_wait(CIRCULAR_BUFFER_ATOMIC(uint32_t) *word, uint32_t expected, const struct timespec *timeout)
+{
+    return syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+}
+
+static void futex_wake(CIRCULAR_BUFFER_ATOMIC(uint32_t) *word)
+{
+    (void)syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+// Wakes the other side if it announced that it is waiting on word.
+static void notify(CIRCULAR_BUFFER_ATOMIC(uint32_t) *waiting, CIRCULAR_BUFFER_ATOMIC(uint32_t) *word)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiting, memory_order_relaxed))
+    {
+        (void)atomic_fetch_add_explicit(word, 1, memory_order_release);
+        futex_wake(word);
+    }
+}
+
+static struct timespec deadline_after(uint32_t timeout_ms)
+{
+    struct timespec deadline;
+    (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return deadline;
+}
+
+// Time left until deadline. Returns false once it has passed.
+static bool time_remaining(const struct timespec *deadline, struct timespec *remaining)
+{
+    struct timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    remaining->tv_sec = deadline->tv_sec - now.tv_sec;
+    remaining->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+    if (remaining->tv_nsec < 0)
+    {
+        remaining->tv_sec--;
+        remaining->tv_nsec += 1000000000L;
+    }
+    return remaining->tv_sec > 0 || (remaining->tv_sec == 0 && remaining->tv_nsec > 0);
+}
+
+// Parks on word until woken or the deadline passes. A NULL deadline waits forever.
+// Returns false once the deadline has passed.
+static bool park(CIRCULAR_BUFFER_ATOMIC(uint32_t) *word, uint32_t seq, const struct timespec *deadline)
+{
+    bool res = true;
+    struct timespec remaining;
+
+    if (!deadline)
+    {
+        (void)futex_wait(word, seq, NULL);
+    }
+    else if (time_remaining(deadline, &remaining))
+    {
+        // EINTR, EAGAIN and ETIMEDOUT all return to the caller's loop, which retries the ring
+        // and then checks the deadline again.
+        (void)futex_wait(word, seq, &remaining);
+    }
+    else
+    {
+        res = false;
+    }
+
+    return res;
+}
+
+// A failed push or pop is taken to mean full or empty, so an invalid ring must be caught before
+// the wait loop, otherwise it would park forever. The capacity query fails only for an invalid ring.
+static bool ring_is_valid(const circular_buffer_wait_ctx *ctx)
+{
+    size_t capacity = 0;
+
+    return circular_buffer_spsc_get_current_capacity(&ctx->ring, &capacity);
+}
+
+bool circular_buffer_wait_init(circular_buffer_wait_ctx *ctx, size_t buff_size)
+{
+    bool res = false;
+
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    if (ctx && buff_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        res = circular_buffer_wait_init_with_storage(ctx, ctx->ring.storage, buff_size);
+    }
+#else
+    (void)ctx;
+    (void)buff_size;
+#endif
+
+    return res;
+}
+
+bool circular_buffer_wait_init_with_storage(circular_buffer_wait_ctx *ctx, uint8_t *mem, size_t len)
+{
+    bool res = false;
+
+    if (ctx && circular_buffer_spsc_init_with_storage(&ctx->ring, mem, len))
+    {
+        atomic_init(&ctx->data_seq, 0);
+        atomic_init(&ctx->space_seq, 0);
+        atomic_init(&ctx->consumer_waiting, 0);
+        atomic_init(&ctx->producer_waiting, 0);
+        res = true;
+    }
+
+    return res;
+}
+
+bool circular_buffer_push_wait(circular_buffer_wait_ctx *ctx, uint8_t data, uint32_t timeout_ms)
+{
+    bool res = false;
+
+    if (ctx && ring_is_valid(ctx))
+    {
+        struct timespec deadline = { 0 };
+        bool waiting = true;
+
+        if (timeout_ms != CIRCULAR_BUFFER_WAIT_FOREVER)
+        {
+            deadline = deadline_after(timeout_ms);
+        }
+
+        res = circular_buffer_spsc_push(&ctx->ring, data);
+
+        while (!res && waiting && timeout_ms > 0)
+        {
+            uint32_t seq = atomic_load_explicit(&ctx->space_seq, memory_order_acquire);
+            atomic_store_explicit(&ctx->producer_waiting, 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+
+            res = circular_buffer_spsc_push(&ctx->ring, data);
+            if (!res)
+            {
+                waiting = park(&ctx->space_seq, seq,
+                               (timeout_ms == CIRCULAR_BUFFER_WAIT_FOREVER) ? NULL : &deadline);
+                res = circular_buffer_spsc_push(&ctx->ring, data);
+            }
+
+            atomic_store_explicit(&ctx->producer_waiting, 0, memory_order_relaxed);
+        }
+
+        if (res)
+        {
+            notify(&ctx->consumer_waiting, &ctx->data_seq);
+        }
+    }
+
+    return res;
+}
+
+bool circular_buffer_pop_wait(circular_buffer_wait_ctx *ctx, uint8_t *data, uint32_t timeout_ms)
+{
+    bool res = false;
+
+    if (ctx && data && ring_is_valid(ctx))
+    {
+        struct timespec deadline = { 0 };
+        bool waiting = true;
+
+        if (timeout_ms != CIRCULAR_BUFFER_WAIT_FOREVER)
+        {
+            deadline = deadline_after(timeout_ms);
+        }
+
+        res = circular_buffer_spsc_pop(&ctx->ring, data);
+
+        while (!res && waiting && timeout_ms > 0)
+        {
+            uint32_t seq = atomic_load_explicit(&ctx->data_seq, memory_order_acquire);
+            atomic_store_explicit(&ctx->consumer_waiting, 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+
+            res = circular_buffer_spsc_pop(&ctx->ring, data);
+            if (!res)
+            {
+                waiting = park(&ctx->data_seq, seq,
+                               (timeout_ms == CIRCULAR_BUFFER_WAIT_FOREVER) ? NULL : &deadline);
+                res = circular_buffer_spsc_pop(&ctx->ring, data);
+            }
+
+            atomic_store_explicit(&ctx->consumer_waiting, 0, memory_order_relaxed);
+        }
+
+        if (res)
+        {
+            notify(&ctx->producer_waiting, &ctx->space_seq);
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file circular_buffer_wait.h
+ * @brief Blocking push and pop with timeouts on top of the single-producer/single-consumer buffer.
+ *
+ * A side that finds the buffer empty (consumer) or full (producer) parks on a futex until the
+ * other side makes progress or the timeout expires. Each side raises a waiting flag before it
+ * parks, and the other side only issues a wake syscall when it sees that flag, so pushes and
+ * pops that do not have to wait never enter the kernel.
+ *
+ * @note Linux only. Built when CIRCULAR_BUFFER_LINUX_EXTENSIONS is on.
+ * Same threading rules as circular_buffer_spsc.h: one producer and one consumer.
+ * All pushes and pops must go through this API so the waiting side gets woken.
+ */
+#ifndef _CIRCULAR_BUFFER_WAIT_H
+#define _CIRCULAR_BUFFER_WAIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "circular_buffer_atomic.h"
+#include "circular_buffer_spsc.h"
+
+/** Timeout that never expires. A timeout of 0 tries once without blocking. */
+#define CIRCULAR_BUFFER_WAIT_FOREVER UINT32_MAX
+
+typedef struct {
+    circular_buffer_spsc_ctx ring;
+    CIRCULAR_BUFFER_ATOMIC(uint32_t) data_seq;          // Futex word the consumer parks on, bumped to wake it
+    CIRCULAR_BUFFER_ATOMIC(uint32_t) space_seq;         // Futex word the producer parks on, bumped to wake it
+    CIRCULAR_BUFFER_ATOMIC(uint32_t) consumer_waiting;  // Set while the consumer is parked or about to park
+    CIRCULAR_BUFFER_ATOMIC(uint32_t) producer_waiting;  // Set while the producer is parked or about to park
+} circular_buffer_wait_ctx;
+
+/**
+ * @brief Initializes an instance of the blocking buffer.
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param buff_size The size of the buffer to instantiate. Must be less than or equal to MAX_BUFFER_SIZE.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_wait_init(circular_buffer_wait_ctx *ctx, size_t buff_size);
+
+/**
+ * @brief Initializes an instance of the blocking buffer over caller-provided storage.
+ * See circular_buffer_init_with_storage().
+ *
+ * @param ctx A blank handle for the buffer.
+ * @param mem The storage to use. Must stay valid for the life of the buffer.
+ * @param len The size of mem in bytes, which becomes the size of the buffer.
+ * @return true if success, false if init failure.
+*/
+bool circular_buffer_wait_init_with_storage(circular_buffer_wait_ctx *ctx, uint8_t *mem, size_t len);
+
+/**
+ * @brief Adds an item to the buffer, waiting for space if it is full. Producer side only.
+ * Wakes the consumer if it is waiting.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A piece of data to push.
+ * @param timeout_ms How long to wait for space. 0 to not wait, CIRCULAR_BUFFER_WAIT_FOREVER for no limit.
+ *
+ * @return true on success, false on timeout or invalid arguments.
+*/
+bool circular_buffer_push_wait(circular_buffer_wait_ctx *ctx, uint8_t data, uint32_t timeout_ms);
+
+/**
+ * @brief Removes an item from the buffer, waiting for data if it is empty. Consumer side only.
+ * Wakes the producer if it is waiting.
+ *
+ * @param ctx A handle for the buffer.
+ * @param data A pointer to return popped data.
+ * @param timeout_ms How long to wait for data. 0 to not wait, CIRCULAR_BUFFER_WAIT_FOREVER for no limit.
+ *
+ * @return true on success, false on timeout or invalid arguments.
+*/
+bool circular_buffer_pop_wait(circular_buffer_wait_ctx *ctx, uint8_t *data, uint32_t timeout_ms);
+
+#endif /* _CIRCULAR_BUFFER_WAIT_H */
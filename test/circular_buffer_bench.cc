@@ -0,0 +1,561 @@
+#include <chrono>
+#include <mutex>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef CIRCULAR_BUFFER_LINUX_EXTENSIONS
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+extern "C" {
+#include "circular_buffer.h"
+#include "circular_buffer_find.h"
+#include "circular_buffer_mpmc.h"
+#include "circular_buffer_pow2.h"
+#include "circular_buffer_sharded.h"
+#include "circular_buffer_spsc.h"
+#ifdef CIRCULAR_BUFFER_LINUX_EXTENSIONS
+#include "circular_buffer_shm.h"
+#endif
+}
+
+// Micro-benchmarks for the buffer hot paths. Prints one result per line as CSV (default)
+// or JSON lines (pass "json"), so results can be diffed between releases.
+//
+// Usage: CircularBufferBench [csv|json]
+
+static volatile uint8_t sink; // Keeps the popped bytes from being optimized away.
+
+struct bench_result {
+    const char *name;
+    size_t buff_size;
+    size_t ops;        // Calls into the buffer API
+    size_t bytes;      // Bytes moved through the buffer
+    double seconds;
+};
+
+static bool json_output = false;
+
+static void report(const bench_result &result)
+{
+    double ns_per_op = (result.seconds * 1e9) / (double)result.ops;
+    double bytes_per_s = (double)result.bytes / result.seconds;
+
+    if (json_output)
+    {
+        (void)printf("{\"name\":\"%s\",\"buff_size\":%zu,\"ops\":%zu,\"ns_per_op\":%.3f,\"bytes_per_s\":%.0f}\n",
+                     result.name, result.buff_size, result.ops, ns_per_op, bytes_per_s);
+    }
+    else
+    {
+        (void)printf("%s,%zu,%zu,%.3f,%.0f\n",
+                     result.name, result.buff_size, result.ops, ns_per_op, bytes_per_s);
+    }
+}
+
+template <typename Fn>
+static void run(const char *name, size_t buff_size, size_t ops, size_t bytes, Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto stop = std::chrono::steady_clock::now();
+    report({ name, buff_size, ops, bytes, std::chrono::duration<double>(stop - start).count() });
+}
+
+// Fills the buffer halfway so head and tail both keep wrapping during a run.
+static void half_fill(circular_buffer_ctx *ctx, size_t buff_size)
+{
+    for (size_t i = 0; i < buff_size / 2; i++)
+    {
+        (void)circular_buffer_push_no_overwrite(ctx, (uint8_t)i);
+    }
+}
+
+static void bench_byte_buffer(size_t buff_size, size_t iterations)
+{
+    static circular_buffer_ctx ctx;
+    std::vector<uint8_t> storage(buff_size);
+    uint8_t data = 0;
+
+    // Single byte push then pop.
+    (void)circular_buffer_init_with_storage(&ctx, storage.data(), buff_size);
+    half_fill(&ctx, buff_size);
+    run("push_pop", buff_size, 2 * iterations, iterations, [&]() {
+        for (size_t i = 0; i < iterations; i++)
+        {
+            (void)circular_buffer_push_no_overwrite(&ctx, (uint8_t)i);
+            (void)circular_buffer_pop(&ctx, &data);
+            sink = data;
+        }
+    });
+
+    // Peek without consuming.
+    run("peek", buff_size, iterations, iterations, [&]() {
+        for (size_t i = 0; i < iterations; i++)
+        {
+            (void)circular_buffer_peek(&ctx, &data);
+            sink = data;
+        }
+    });
+
+    // Overwrite under a full buffer, every push drops the oldest byte.
+    (void)circular_buffer_init_with_storage(&ctx, storage.data(), buff_size);
+    while (circular_buffer_push_no_overwrite(&ctx, 0)) {}
+    run("push_overwrite_full", buff_size, iterations, iterations, [&]() {
+        for (size_t i = 0; i < iterations; i++)
+        {
+            (void)circular_buffer_push_with_overwrite(&ctx, (uint8_t)i);
+        }
+    });
+
+    // Mixed pattern: a producer burst of half the buffer, then the consumer drains it.
+    size_t burst = (buff_size / 2) ? (buff_size / 2) : 1;
+    size_t rounds = iterations / burst;
+    (void)circular_buffer_init_with_storage(&ctx, storage.data(), buff_size);
+    run("burst_push_pop", buff_size, 2 * rounds * burst, rounds * burst, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+        {
+            for (size_t i = 0; i < burst; i++)
+            {
+                (void)circular_buffer_push_no_overwrite(&ctx, (uint8_t)i);
+            }
+            for (size_t i = 0; i < burst; i++)
+            {
+                (void)circular_buffer_pop(&ctx, &data);
+                sink = data;
+            }
+        }
+    });
+
+    // The same bursts through the bulk API.
+    std::vector<uint8_t> chunk(burst);
+    (void)circular_buffer_init_with_storage(&ctx, storage.data(), buff_size);
+    half_fill(&ctx, buff_size);
+    run("burst_write_read", buff_size, 2 * rounds, rounds * burst, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+        {
+            (void)circular_buffer_write(&ctx, chunk.data(), burst, false);
+            (void)circular_buffer_read(&ctx, chunk.data(), burst);
+            sink = chunk[0];
+        }
+    });
+
+    // Delimiter scan over a full, wrapped buffer with the match in the newest byte.
+    std::vector<uint8_t> line(buff_size, 'a');
+    size_t scans = (iterations / buff_size) ? (iterations / buff_size) : 1;
+    size_t offset = 0;
+    line[buff_size - 1] = '\n';
+    (void)circular_buffer_init_with_storage(&ctx, storage.data(), buff_size);
+    (void)circular_buffer_commit(&ctx, buff_size / 2);
+    (void)circular_buffer_consume(&ctx, buff_size / 2);
+    (void)circular_buffer_write(&ctx, line.data(), buff_size, false);
+    run("find_byte", buff_size, scans, scans * buff_size, [&]() {
+        for (size_t i = 0; i < scans; i++)
+        {
+            (void)circular_buffer_find(&ctx, '\n', &offset);
+            sink = (uint8_t)offset;
+        }
+    });
+}
+
+static void bench_pow2_buffer(size_t buff_size, size_t iterations)
+{
+    static circular_buffer_pow2_ctx ctx;
+    std::vector<uint8_t> storage(buff_size);
+    uint8_t data = 0;
+
+    if (!circular_buffer_pow2_init_with_storage(&ctx, storage.data(), buff_size))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < buff_size / 2; i++)
+    {
+        (void)circular_buffer_pow2_push_no_overwrite(&ctx, (uint8_t)i);
+    }
+    run("pow2_push_pop", buff_size, 2 * iterations, iterations, [&]() {
+        for (size_t i = 0; i < iterations; i++)
+        {
+            (void)circular_buffer_pow2_push_no_overwrite(&ctx, (uint8_t)i);
+            (void)circular_buffer_pow2_pop(&ctx, &data);
+            sink = data;
+        }
+    });
+}
+
+static void bench_spsc_buffer(size_t buff_size, size_t iterations)
+{
+    static circular_buffer_spsc_ctx ctx;
+    std::vector<uint8_t> storage(buff_size);
+
+    (void)circular_buffer_spsc_init_with_storage(&ctx, storage.data(), buff_size);
+
+    // Mixed pattern across two threads: one producer, one consumer.
+    run("spsc_two_thread", buff_size, 2 * iterations, iterations, [&]() {
+        std::thread consumer([&]() {
+            uint8_t data = 0;
+            for (size_t i = 0; i < iterations; i++)
+            {
+                while (!circular_buffer_spsc_pop(&ctx, &data))
+                {
+                    std::this_thread::yield();
+                }
+                sink = data;
+            }
+        });
+
+        for (size_t i = 0; i < iterations; i++)
+        {
+            while (!circular_buffer_spsc_push(&ctx, (uint8_t)i))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        consumer.join();
+    });
+}
+
+// Round trip of a single byte between two threads over a pair of SPSC buffers. Each
+// hop moves the index cache lines between cores, so this shows the cost of the ctx
+// layout; build with CIRCULAR_BUFFER_CACHE_LINE_SIZE=0 and =64 to compare.
+static void bench_spsc_ping_pong(size_t buff_size, size_t round_trips)
+{
+    static circular_buffer_spsc_ctx ping;
+    static circular_buffer_spsc_ctx pong;
+    std::vector<uint8_t> ping_storage(buff_size);
+    std::vector<uint8_t> pong_storage(buff_size);
+
+    (void)circular_buffer_spsc_init_with_storage(&ping, ping_storage.data(), buff_size);
+    (void)circular_buffer_spsc_init_with_storage(&pong, pong_storage.data(), buff_size);
+
+    run("spsc_ping_pong", buff_size, 4 * round_trips, 2 * round_trips, [&]() {
+        std::thread echo([&]() {
+            uint8_t data = 0;
+            for (size_t i = 0; i < round_trips; i++)
+            {
+                while (!circular_buffer_spsc_pop(&ping, &data)) {}
+                while (!circular_buffer_spsc_push(&pong, data)) {}
+            }
+        });
+
+        uint8_t data = 0;
+        for (size_t i = 0; i < round_trips; i++)
+        {
+            while (!circular_buffer_spsc_push(&ping, (uint8_t)i)) {}
+            while (!circular_buffer_spsc_pop(&pong, &data)) {}
+            sink = data;
+        }
+
+        echo.join();
+    });
+}
+
+// Runs pairs producer/consumer pairs over one shared buffer, moving total_bytes between them.
+template <typename PushFn, typename PopFn>
+static void run_contention(const char *name, size_t buff_size, size_t pairs, size_t total_bytes,
+                           PushFn push, PopFn pop)
+{
+    size_t share = total_bytes / pairs;
+
+    run(name, buff_size, 2 * share * pairs, share * pairs, [&]() {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < pairs; t++)
+        {
+            threads.emplace_back([&]() {
+                for (size_t i = 0; i < share; i++)
+                {
+                    while (!push((uint8_t)i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            threads.emplace_back([&]() {
+                uint8_t data = 0;
+                for (size_t i = 0; i < share; i++)
+                {
+                    while (!pop(&data))
+                    {
+                        std::this_thread::yield();
+                    }
+                    sink = data;
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    });
+}
+
+// Throughput of the lock-free MPMC buffer against a mutex-guarded byte buffer as the
+// number of producer/consumer pairs grows from 1 up to the core count.
+static void bench_contention(size_t buff_size, size_t total_bytes)
+{
+    static circular_buffer_mpmc_ctx mpmc_ctx;
+    static circular_buffer_ctx locked_ctx;
+    std::vector<circular_buffer_mpmc_slot> slots(buff_size);
+    std::vector<uint8_t> storage(buff_size);
+    std::mutex lock;
+    size_t max_pairs = std::thread::hardware_concurrency() / 2;
+    char name[64];
+
+    if (!circular_buffer_mpmc_init_with_storage(&mpmc_ctx, slots.data(), buff_size) ||
+        !circular_buffer_init_with_storage(&locked_ctx, storage.data(), buff_size))
+    {
+        return;
+    }
+
+    for (size_t pairs = 1; pairs <= max_pairs || pairs == 1; pairs *= 2)
+    {
+        (void)snprintf(name, sizeof(name), "mpmc_contention_%zux%zu", pairs, pairs);
+        run_contention(name, buff_size, pairs, total_bytes,
+            [&](uint8_t data) { return circular_buffer_mpmc_push(&mpmc_ctx, data); },
+            [&](uint8_t *data) { return circular_buffer_mpmc_pop(&mpmc_ctx, data); });
+
+        (void)snprintf(name, sizeof(name), "mutex_contention_%zux%zu", pairs, pairs);
+        run_contention(name, buff_size, pairs, total_bytes,
+            [&](uint8_t data) {
+                std::lock_guard<std::mutex> guard(lock);
+                return circular_buffer_push_no_overwrite(&locked_ctx, data);
+            },
+            [&](uint8_t *data) {
+                std::lock_guard<std::mutex> guard(lock);
+                return circular_buffer_pop(&locked_ctx, data);
+            });
+    }
+}
+
+// Runs producers producer threads against one consumer that drains in batches, moving total_bytes.
+template <typename PushFn, typename ReadFn>
+static void run_fan_in(const char *name, size_t buff_size, size_t producers, size_t total_bytes,
+                       PushFn push, ReadFn read)
+{
+    size_t share = total_bytes / producers;
+
+    run(name, buff_size, 2 * share * producers, share * producers, [&]() {
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; p++)
+        {
+            threads.emplace_back([&, p]() {
+                for (size_t i = 0; i < share; i++)
+                {
+                    while (!push(p, (uint8_t)i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        uint8_t batch[64];
+        size_t received = 0;
+        while (received < share * producers)
+        {
+            size_t read_len = read(batch, sizeof(batch));
+            if (read_len == 0)
+            {
+                std::this_thread::yield();
+            }
+            sink = batch[0];
+            received += read_len;
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    });
+}
+
+// Many producers feeding one consumer: one SPSC shard per producer against a single
+// mutex-guarded byte buffer of the same total size, from 1 producer up to the core count.
+static void bench_fan_in(size_t shard_size, size_t total_bytes)
+{
+    size_t max_producers = std::thread::hardware_concurrency();
+    char name[64];
+
+    for (size_t producers = 1; producers <= max_producers || producers == 1; producers *= 2)
+    {
+        static circular_buffer_sharded_ctx sharded_ctx;
+        static circular_buffer_ctx locked_ctx;
+        std::vector<circular_buffer_spsc_ctx> shards(producers);
+        std::vector<uint8_t> sharded_storage(producers * shard_size + CIRCULAR_BUFFER_CACHE_LINE_SIZE);  // Room to align the first shard
+        std::vector<uint8_t> locked_storage(producers * shard_size);
+        std::mutex lock;
+
+        if (!circular_buffer_sharded_init_with_storage(&sharded_ctx, shards.data(), producers,
+                                                       sharded_storage.data(), sharded_storage.size(),
+                                                       CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN) ||
+            !circular_buffer_init_with_storage(&locked_ctx, locked_storage.data(), locked_storage.size()))
+        {
+            return;
+        }
+
+        (void)snprintf(name, sizeof(name), "sharded_fan_in_%zux1", producers);
+        run_fan_in(name, shard_size, producers, total_bytes,
+            [&](size_t shard, uint8_t data) { return circular_buffer_sharded_push(&sharded_ctx, shard, data); },
+            [&](uint8_t *dst, size_t len) {
+                size_t read_len = 0;
+                (void)circular_buffer_sharded_read(&sharded_ctx, dst, len, &read_len, NULL);
+                return read_len;
+            });
+
+        (void)snprintf(name, sizeof(name), "mutex_fan_in_%zux1", producers);
+        run_fan_in(name, shard_size, producers, total_bytes,
+            [&](size_t, uint8_t data) {
+                std::lock_guard<std::mutex> guard(lock);
+                return circular_buffer_push_no_overwrite(&locked_ctx, data);
+            },
+            [&](uint8_t *dst, size_t len) {
+                std::lock_guard<std::mutex> guard(lock);
+                size_t capacity = 0;
+                (void)circular_buffer_get_current_capacity(&locked_ctx, &capacity);
+                size_t stored = locked_ctx.buff_size - capacity;
+                size_t read_len = (stored < len) ? stored : len;
+                (void)circular_buffer_read(&locked_ctx, dst, read_len);
+                return read_len;
+            });
+    }
+}
+
+#ifdef CIRCULAR_BUFFER_LINUX_EXTENSIONS
+// Moves total_bytes from a forked child to this process in chunks of chunk_len, through a
+// shared memory buffer and through a pipe. The pipe copies every byte into and out of the kernel.
+static void bench_ipc(size_t buff_size, size_t chunk_len, size_t total_bytes)
+{
+    std::string name = "/circular_buffer_bench_" + std::to_string(getpid());
+    static circular_buffer_shm_ctx shm_ctx;
+    std::vector<uint8_t> chunk(chunk_len);
+    size_t chunks = total_bytes / chunk_len;
+    int fds[2];
+
+    (void)shm_unlink(name.c_str());
+    if (!circular_buffer_shm_create(&shm_ctx, name.c_str(), buff_size))
+    {
+        return;
+    }
+
+    run("shm_ipc", buff_size, 2 * chunks, chunks * chunk_len, [&]() {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            circular_buffer_shm_ctx producer;
+            if (!circular_buffer_shm_attach(&producer, name.c_str()))
+            {
+                _exit(1);
+            }
+            for (size_t i = 0; i < chunks; i++)
+            {
+                while (!circular_buffer_shm_write(&producer, chunk.data(), chunk_len))
+                {
+                    sched_yield();
+                }
+            }
+            _exit(0);
+        }
+
+        size_t received = 0;
+        bool child_exited = false;
+        while (pid > 0 && received < chunks * chunk_len)
+        {
+            size_t read_len = 0;
+            if (!circular_buffer_shm_read(&shm_ctx, chunk.data(), chunk_len, &read_len))
+            {
+                // Give up once the child is gone, e.g. it failed to attach, and nothing is left to read.
+                if (child_exited)
+                {
+                    break;
+                }
+                child_exited = (waitpid(pid, NULL, WNOHANG) == pid);
+                sched_yield();
+            }
+            received += read_len;
+        }
+        sink = chunk[0];
+        if (pid > 0 && !child_exited)
+        {
+            (void)waitpid(pid, NULL, 0);
+        }
+    });
+
+    (void)circular_buffer_shm_detach(&shm_ctx);
+    (void)shm_unlink(name.c_str());
+
+    if (pipe(fds) != 0)
+    {
+        return;
+    }
+
+    run("pipe_ipc", buff_size, 2 * chunks, chunks * chunk_len, [&]() {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            (void)close(fds[0]);
+            for (size_t i = 0; i < chunks; i++)
+            {
+                (void)write(fds[1], chunk.data(), chunk_len);
+            }
+            _exit(0);
+        }
+
+        size_t received = 0;
+        while (pid > 0 && received < chunks * chunk_len)
+        {
+            ssize_t n = read(fds[0], chunk.data(), chunk_len);
+            if (n <= 0)
+            {
+                break;
+            }
+            received += (size_t)n;
+        }
+        sink = chunk[0];
+        (void)waitpid(pid, NULL, 0);
+    });
+
+    (void)close(fds[0]);
+    (void)close(fds[1]);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    const size_t iterations = 10000000;
+    const size_t sizes[] = { 64, 256, 1024, 65536 };
+
+    json_output = (argc > 1 && strcmp(argv[1], "json") == 0);
+
+    if (!json_output)
+    {
+        (void)printf("name,buff_size,ops,ns_per_op,bytes_per_s\n");
+    }
+
+    for (size_t size : sizes)
+    {
+        bench_byte_buffer(size, iterations);
+        bench_pow2_buffer(size, iterations);
+        bench_spsc_buffer(size, iterations);
+    }
+
+    // Busy-waits, so only meaningful with at least two cores.
+    if (std::thread::hardware_concurrency() > 1)
+    {
+        bench_spsc_ping_pong(64, iterations / 10);
+    }
+    bench_contention(1024, iterations / 4);
+    bench_fan_in(1024, iterations / 4);
+#ifdef CIRCULAR_BUFFER_LINUX_EXTENSIONS
+    bench_ipc(65536, 4096, iterations * 40);
+#endif
+
+    return 0;
+}
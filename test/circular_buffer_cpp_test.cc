@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "circular_buffer.hpp"
+
+// Mirrors circular_buffer_test.cc for the C++ template.
+
+class CircularBufferCppTest : public ::testing::Test {
+protected:
+    static constexpr size_t buff_size = 256;
+    CircularBuffer<uint8_t, buff_size> buffer;
+};
+
+constexpr size_t CircularBufferCppTest::buff_size;
+
+/****************** SECTION: Compile Time ************************/
+
+// Runs entirely at compile time: push three into a two slot buffer, pop the survivors.
+constexpr int constexpr_push_pop()
+{
+    CircularBuffer<int, 2> buffer;
+    int first = 0, second = 0;
+    buffer.push_with_overwrite(1);
+    buffer.push_with_overwrite(2);
+    buffer.push_with_overwrite(3);
+    buffer.pop(first);
+    buffer.pop(second);
+    return (first * 10) + second + (int)buffer.overflow_count() * 100;
+}
+
+static_assert(constexpr_push_pop() == 123, "CircularBuffer must be usable in constant expressions");
+static_assert(CircularBuffer<int, 7>::capacity() == 7, "Capacity is a compile time constant");
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferCppTest, PushPopData)
+{
+    uint8_t data_out = 0;
+    ASSERT_TRUE(buffer.push_with_overwrite(42));
+    ASSERT_TRUE(buffer.pop(data_out));
+    EXPECT_EQ(data_out, 42);
+}
+
+TEST_F(CircularBufferCppTest, PushPopDataNTimesNoOverwrite)
+{
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(buffer.push_no_overwrite((uint8_t)i));
+    }
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        uint8_t data_out = 0;
+        ASSERT_TRUE(buffer.pop(data_out));
+        EXPECT_EQ(data_out, (uint8_t)i);
+    }
+}
+
+TEST_F(CircularBufferCppTest, PeekData)
+{
+    uint8_t data_out = 0;
+    ASSERT_EQ(buffer.peek(), nullptr);
+    ASSERT_TRUE(buffer.push_with_overwrite(7));
+    ASSERT_NE(buffer.peek(), nullptr);
+    EXPECT_EQ(*buffer.peek(), 7);
+
+    // Ensure that peek didn't pop the data.
+    ASSERT_TRUE(buffer.pop(data_out));
+    EXPECT_EQ(data_out, 7);
+}
+
+TEST_F(CircularBufferCppTest, IsEmptyIsFullAndCapacity)
+{
+    ASSERT_TRUE(buffer.is_empty());
+    ASSERT_FALSE(buffer.is_full());
+    EXPECT_EQ(buffer.current_capacity(), buff_size);
+
+    for (size_t i = 0; i < 20; i++)
+    {
+        ASSERT_TRUE(buffer.push_no_overwrite(0));
+    }
+    EXPECT_EQ(buffer.size(), 20);
+    EXPECT_EQ(buffer.current_capacity(), buff_size - 20);
+
+    for (size_t i = 20; i < buff_size; i++)
+    {
+        ASSERT_TRUE(buffer.push_no_overwrite(0));
+    }
+    ASSERT_TRUE(buffer.is_full());
+    ASSERT_FALSE(buffer.is_empty());
+}
+
+TEST_F(CircularBufferCppTest, OverwritesOldestValueIfFullOnPush)
+{
+    uint8_t data_out = 0;
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(buffer.push_with_overwrite(1));
+    }
+    EXPECT_EQ(buffer.overflow_count(), 0);
+
+    ASSERT_TRUE(buffer.push_with_overwrite(2));
+    EXPECT_EQ(buffer.overflow_count(), 1);
+
+    for (size_t i = 0; i < (buff_size - 1); i++)
+    {
+        ASSERT_TRUE(buffer.pop(data_out));
+        EXPECT_EQ(data_out, 1);
+    }
+    ASSERT_TRUE(buffer.pop(data_out));
+    EXPECT_EQ(data_out, 2);
+    ASSERT_FALSE(buffer.pop(data_out));
+
+    buffer.clear_overflow_count();
+    EXPECT_EQ(buffer.overflow_count(), 0);
+}
+
+TEST_F(CircularBufferCppTest, PushNoOverwriteFailsForFullBuffer)
+{
+    uint8_t data_out = 0;
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(buffer.push_no_overwrite((uint8_t)i));
+    }
+    ASSERT_FALSE(buffer.push_no_overwrite(0xFF));
+    EXPECT_EQ(buffer.overflow_count(), 0);
+
+    ASSERT_TRUE(buffer.pop(data_out));
+    EXPECT_EQ(data_out, 0);
+}
+
+TEST_F(CircularBufferCppTest, IteratesOldestToNewestAcrossWrapPoint)
+{
+    CircularBuffer<int, 5> small;
+    std::vector<int> seen;
+
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(small.push_with_overwrite(i));
+    }
+
+    for (int value : small)
+    {
+        seen.push_back(value);
+    }
+    EXPECT_EQ(seen, (std::vector<int>{ 3, 4, 5, 6, 7 }));
+
+    // Mutable iteration writes through to the stored items.
+    for (auto it = small.begin(); it != small.end(); ++it)
+    {
+        *it *= 10;
+    }
+
+    const auto &const_small = small;
+    seen.assign(const_small.cbegin(), const_small.cend());
+    EXPECT_EQ(seen, (std::vector<int>{ 30, 40, 50, 60, 70 }));
+}
+
+TEST_F(CircularBufferCppTest, SupportsMoveOnlyElements)
+{
+    CircularBuffer<std::unique_ptr<int>, 2> owners;
+    std::unique_ptr<int> out;
+
+    ASSERT_TRUE(owners.push_no_overwrite(std::unique_ptr<int>(new int(1))));
+    ASSERT_TRUE(owners.push_no_overwrite(std::unique_ptr<int>(new int(2))));
+
+    // A failed push must not take ownership.
+    std::unique_ptr<int> rejected(new int(3));
+    ASSERT_FALSE(owners.push_no_overwrite(std::move(rejected)));
+    ASSERT_NE(rejected, nullptr);
+
+    // Overwriting releases the oldest element.
+    ASSERT_TRUE(owners.push_with_overwrite(std::move(rejected)));
+    EXPECT_EQ(owners.overflow_count(), 1);
+
+    ASSERT_TRUE(owners.pop(out));
+    EXPECT_EQ(*out, 2);
+    ASSERT_TRUE(owners.pop(out));
+    EXPECT_EQ(*out, 3);
+    ASSERT_FALSE(owners.pop(out));
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferCppTest, PopAndPeekFailForEmptyBuffer)
+{
+    uint8_t data_out = 0;
+    ASSERT_FALSE(buffer.pop(data_out));
+    ASSERT_TRUE(buffer.push_with_overwrite(1));
+    ASSERT_TRUE(buffer.pop(data_out));
+    ASSERT_FALSE(buffer.pop(data_out));
+    ASSERT_EQ(buffer.peek(), nullptr);
+}
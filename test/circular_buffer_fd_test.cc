@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_fd.h"
+}
+
+class CircularBufferFdTest : public ::testing::Test {
+protected:
+    size_t buff_size = 64;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(buff_size);  // Caller storage works in every build
+    circular_buffer_ctx ctx;
+    int fds[2] = { -1, -1 };  // Read end, write end
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_init_with_storage(&ctx, storage.data(), storage.size()));
+        ASSERT_EQ(pipe(fds), 0);
+    }
+
+    void TearDown() override {
+        for (int fd : fds)
+        {
+            if (fd >= 0)
+            {
+                (void)close(fd);
+            }
+        }
+    }
+
+    void set_non_blocking(int fd) {
+        ASSERT_EQ(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK), 0);
+    }
+
+    // Moves head and tail to offset so the next transfer straddles the wrap point.
+    void advance_to(size_t offset) {
+        ASSERT_TRUE(circular_buffer_commit(&ctx, offset));
+        ASSERT_TRUE(circular_buffer_consume(&ctx, offset));
+    }
+};
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferFdTest, HandlesNullArguments)
+{
+    size_t len = 0;
+    errno = 0;
+    ASSERT_FALSE(circular_buffer_fill_from_fd(NULL, fds[0], &len));
+    EXPECT_EQ(errno, EINVAL);
+    ASSERT_FALSE(circular_buffer_fill_from_fd(&ctx, fds[0], NULL));
+    ASSERT_FALSE(circular_buffer_drain_to_fd(NULL, fds[1], &len));
+    ASSERT_FALSE(circular_buffer_drain_to_fd(&ctx, fds[1], NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferFdTest, FillAndDrainAcrossWrapPoint)
+{
+    std::vector<uint8_t> in(40), out(40);
+    size_t len = 0;
+
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        in[i] = (uint8_t)(i * 7);
+    }
+
+    advance_to(buff_size - 10);
+    ASSERT_EQ(write(fds[1], in.data(), in.size()), (ssize_t)in.size());
+
+    // A short read: the pipe holds less than the free space.
+    ASSERT_TRUE(circular_buffer_fill_from_fd(&ctx, fds[0], &len));
+    EXPECT_EQ(len, in.size());
+    EXPECT_EQ(ctx.current_byte_count, in.size());
+
+    ASSERT_TRUE(circular_buffer_drain_to_fd(&ctx, fds[1], &len));
+    EXPECT_EQ(len, in.size());
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+
+    ASSERT_EQ(read(fds[0], out.data(), out.size()), (ssize_t)out.size());
+    EXPECT_EQ(in, out);
+}
+
+TEST_F(CircularBufferFdTest, FillStopsAtFreeSpace)
+{
+    std::vector<uint8_t> in(buff_size + 16, 0x11);
+    size_t len = 0;
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0x22));
+    ASSERT_EQ(write(fds[1], in.data(), in.size()), (ssize_t)in.size());
+
+    ASSERT_TRUE(circular_buffer_fill_from_fd(&ctx, fds[0], &len));
+    EXPECT_EQ(len, buff_size - 1);
+    ASSERT_TRUE(circular_buffer_is_full(&ctx));
+
+    errno = 0;
+    ASSERT_FALSE(circular_buffer_fill_from_fd(&ctx, fds[0], &len));
+    EXPECT_EQ(errno, ENOBUFS);
+    EXPECT_EQ(len, 0);
+}
+
+TEST_F(CircularBufferFdTest, FillReportsEndOfFile)
+{
+    size_t len = 1;
+    (void)close(fds[1]);
+    fds[1] = -1;
+
+    ASSERT_TRUE(circular_buffer_fill_from_fd(&ctx, fds[0], &len));
+    EXPECT_EQ(len, 0);
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferFdTest, DrainOfEmptyBufferIsANoOp)
+{
+    size_t len = 1;
+    ASSERT_TRUE(circular_buffer_drain_to_fd(&ctx, fds[1], &len));
+    EXPECT_EQ(len, 0);
+}
+
+/****************** SECTION: Non-Blocking File Descriptors ************************/
+
+TEST_F(CircularBufferFdTest, FillReturnsEagainWithoutData)
+{
+    size_t len = 1;
+    set_non_blocking(fds[0]);
+
+    errno = 0;
+    ASSERT_FALSE(circular_buffer_fill_from_fd(&ctx, fds[0], &len));
+    EXPECT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK);
+    EXPECT_EQ(len, 0);
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferFdTest, DrainKeepsWhatTheFdDidNotAccept)
+{
+    std::vector<uint8_t> filler(4096, 0);
+    size_t len = 0;
+    set_non_blocking(fds[1]);
+
+    // Fill the pipe until it refuses more.
+    while (write(fds[1], filler.data(), filler.size()) > 0) {}
+    while (write(fds[1], filler.data(), 1) > 0) {}
+
+    ASSERT_TRUE(circular_buffer_write(&ctx, filler.data(), 10, false));
+    errno = 0;
+    ASSERT_FALSE(circular_buffer_drain_to_fd(&ctx, fds[1], &len));
+    EXPECT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK);
+    EXPECT_EQ(len, 0);
+    EXPECT_EQ(ctx.current_byte_count, 10);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_find.h"
+}
+
+class CircularBufferFindTest : public ::testing::Test {
+protected:
+    size_t buff_size = 256;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(buff_size);  // Caller storage works in every build
+    circular_buffer_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_init_with_storage(&ctx, storage.data(), storage.size()));
+    }
+
+    // Stores data starting at storage position start, so it wraps when start + size > buff_size.
+    void store_at(size_t start, const std::vector<uint8_t> &data) {
+        ASSERT_TRUE(circular_buffer_commit(&ctx, start));
+        ASSERT_TRUE(circular_buffer_consume(&ctx, start));
+        ASSERT_TRUE(circular_buffer_write(&ctx, data.data(), data.size(), false));
+    }
+};
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferFindTest, HandlesNullArguments)
+{
+    const uint8_t pattern[] = { 1, 2 };
+    size_t offset = 0;
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_find(NULL, 1, &offset));
+    ASSERT_FALSE(circular_buffer_find(&ctx, 1, NULL));
+    ASSERT_FALSE(circular_buffer_find_pattern(NULL, pattern, sizeof(pattern), &offset));
+    ASSERT_FALSE(circular_buffer_find_pattern(&ctx, NULL, sizeof(pattern), &offset));
+    ASSERT_FALSE(circular_buffer_find_pattern(&ctx, pattern, 0, &offset));
+    ASSERT_FALSE(circular_buffer_find_pattern(&ctx, pattern, sizeof(pattern), NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferFindTest, FindsNothingInEmptyBuffer)
+{
+    const uint8_t pattern[] = { 0 };
+    size_t offset = 0;
+    ASSERT_FALSE(circular_buffer_find(&ctx, 0, &offset));
+    ASSERT_FALSE(circular_buffer_find_pattern(&ctx, pattern, sizeof(pattern), &offset));
+}
+
+TEST_F(CircularBufferFindTest, FindsFirstByteAtEveryOffsetAndWrapPosition)
+{
+    // Covers matches in the vector body, the remainder, and either run of a wrapped buffer.
+    for (size_t start = 0; start < buff_size; start += 37)
+    {
+        for (size_t match = 0; match < buff_size; match += 13)
+        {
+            std::vector<uint8_t> data(buff_size, 'a');
+            size_t offset = 0;
+            data[match] = '\n';
+            if (match + 1 < buff_size)
+            {
+                data[match + 1] = '\n';  // Only the first match counts.
+            }
+
+            ASSERT_TRUE(circular_buffer_init_with_storage(&ctx, storage.data(), storage.size()));
+            store_at(start, data);
+            ASSERT_TRUE(circular_buffer_find(&ctx, '\n', &offset)) << "start " << start << " match " << match;
+            EXPECT_EQ(offset, match) << "start " << start;
+            ASSERT_FALSE(circular_buffer_find(&ctx, 'b', &offset));
+        }
+    }
+}
+
+TEST_F(CircularBufferFindTest, IgnoresBytesOutsideStoredData)
+{
+    size_t offset = 0;
+    std::vector<uint8_t> data(10, 'x');
+
+    // Leave a match behind in storage, then consume it.
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, '\n'));
+    ASSERT_TRUE(circular_buffer_consume(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_write(&ctx, data.data(), data.size(), false));
+    ASSERT_FALSE(circular_buffer_find(&ctx, '\n', &offset));
+}
+
+TEST_F(CircularBufferFindTest, FindsPatternSpanningWrapPoint)
+{
+    const uint8_t crlf[] = { '\r', '\n' };
+    const uint8_t sync[] = { 0xAA, 0x55, 0xAA, 0x56 };
+    std::vector<uint8_t> data(40, 0);
+    size_t offset = 0;
+
+    // A near miss first, then the real sync word split across the end of storage.
+    data[3] = 0xAA; data[4] = 0x55; data[5] = 0xAA; data[6] = 0x00;
+    data[18] = 0xAA; data[19] = 0x55; data[20] = 0xAA; data[21] = 0x56;
+    data[30] = '\r'; data[31] = '\n';
+    store_at(buff_size - 20, data);
+
+    ASSERT_TRUE(circular_buffer_find_pattern(&ctx, sync, sizeof(sync), &offset));
+    EXPECT_EQ(offset, 18);
+    ASSERT_TRUE(circular_buffer_find_pattern(&ctx, crlf, sizeof(crlf), &offset));
+    EXPECT_EQ(offset, 30);
+
+    // A pattern longer than the stored data never matches.
+    std::vector<uint8_t> long_pattern(41, 0);
+    ASSERT_FALSE(circular_buffer_find_pattern(&ctx, long_pattern.data(), long_pattern.size(), &offset));
+}
+
+TEST_F(CircularBufferFindTest, FindThenReadPullsOneLine)
+{
+    const char text[] = "first line\nsecond";
+    std::vector<uint8_t> line;
+    size_t offset = 0;
+
+    ASSERT_TRUE(circular_buffer_write(&ctx, (const uint8_t *)text, sizeof(text) - 1, false));
+    ASSERT_TRUE(circular_buffer_find(&ctx, '\n', &offset));
+    line.resize(offset + 1);
+    ASSERT_TRUE(circular_buffer_read(&ctx, line.data(), line.size()));
+    EXPECT_EQ(std::string(line.begin(), line.end()), "first line\n");
+    ASSERT_FALSE(circular_buffer_find(&ctx, '\n', &offset));
+}
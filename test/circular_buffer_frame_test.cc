@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_frame.h"
+}
+
+class CircularBufferFrameTest : public ::testing::Test {
+protected:
+    size_t buff_size = 256;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(buff_size);  // Caller storage works in every build
+    circular_buffer_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_init_with_storage(&ctx, storage.data(), storage.size()));
+    }
+
+    static std::vector<uint8_t> make_message(size_t len, uint8_t seed) {
+        std::vector<uint8_t> msg(len);
+        for (size_t i = 0; i < len; i++)
+        {
+            msg[i] = (uint8_t)(seed + i);
+        }
+        return msg;
+    }
+};
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferFrameTest, HandlesNullArguments)
+{
+    uint8_t msg[4] = { 0 };
+    size_t len = 0;
+    circular_buffer_frame_view view;
+    ASSERT_FALSE(circular_buffer_frame_push(NULL, msg, sizeof(msg), false));
+    ASSERT_FALSE(circular_buffer_frame_push(&ctx, NULL, sizeof(msg), false));
+    ASSERT_TRUE(circular_buffer_frame_push(&ctx, msg, sizeof(msg), false));
+    ASSERT_FALSE(circular_buffer_frame_pop(NULL, msg, sizeof(msg), &len));
+    ASSERT_FALSE(circular_buffer_frame_pop(&ctx, NULL, sizeof(msg), &len));
+    ASSERT_FALSE(circular_buffer_frame_pop(&ctx, msg, sizeof(msg), NULL));
+    ASSERT_FALSE(circular_buffer_frame_peek(NULL, &view));
+    ASSERT_FALSE(circular_buffer_frame_peek(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_frame_discard(NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferFrameTest, PushPopMessagesOfVaryingLength)
+{
+    std::vector<uint8_t> out(buff_size);
+    size_t len = 0;
+
+    // Lengths on both sides of the one byte header limit, plus an empty message.
+    const size_t lengths[] = { 1, 0, 127, 17, 100 };
+    for (size_t i = 0; i < 5; i++)
+    {
+        std::vector<uint8_t> msg = make_message(lengths[i], (uint8_t)i);
+        ASSERT_TRUE(circular_buffer_frame_push(&ctx, msg.data(), msg.size(), false));
+        ASSERT_TRUE(circular_buffer_frame_pop(&ctx, out.data(), out.size(), &len));
+        ASSERT_EQ(len, lengths[i]);
+        EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + len), msg);
+    }
+
+    // A 128 byte message needs a two byte header and still fits.
+    std::vector<uint8_t> msg = make_message(128, 7);
+    ASSERT_TRUE(circular_buffer_frame_push(&ctx, msg.data(), msg.size(), false));
+    ASSERT_TRUE(circular_buffer_frame_pop(&ctx, out.data(), out.size(), &len));
+    ASSERT_EQ(len, 128);
+    EXPECT_EQ(memcmp(out.data(), msg.data(), len), 0);
+
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_frame_pop(&ctx, out.data(), out.size(), &len));
+}
+
+TEST_F(CircularBufferFrameTest, PushIsAllOrNothing)
+{
+    std::vector<uint8_t> big = make_message(200, 1);
+    std::vector<uint8_t> second = make_message(100, 2);
+    std::vector<uint8_t> out(buff_size);
+    size_t len = 0;
+
+    ASSERT_TRUE(circular_buffer_frame_push(&ctx, big.data(), big.size(), false));
+    ASSERT_FALSE(circular_buffer_frame_push(&ctx, second.data(), second.size(), false));
+
+    // Too big for the buffer even when empty, in either mode.
+    std::vector<uint8_t> huge = make_message(buff_size, 3);
+    ASSERT_FALSE(circular_buffer_frame_push(&ctx, huge.data(), huge.size(), true));
+
+    ASSERT_TRUE(circular_buffer_frame_pop(&ctx, out.data(), out.size(), &len));
+    ASSERT_EQ(len, big.size());
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferFrameTest, PopLeavesMessageWhenDstTooSmall)
+{
+    std::vector<uint8_t> msg = make_message(32, 1);
+    std::vector<uint8_t> out(buff_size);
+    size_t len = 0;
+
+    ASSERT_TRUE(circular_buffer_frame_push(&ctx, msg.data(), msg.size(), false));
+    ASSERT_FALSE(circular_buffer_frame_pop(&ctx, out.data(), 31, &len));
+    ASSERT_TRUE(circular_buffer_frame_pop(&ctx, out.data(), 32, &len));
+    EXPECT_EQ(memcmp(out.data(), msg.data(), len), 0);
+}
+
+TEST_F(CircularBufferFrameTest, OverwriteEvictsWholeOldestMessages)
+{
+    std::vector<uint8_t> out(buff_size);
+    size_t len = 0;
+    uint32_t overflow_count = 0;
+
+    // 50 messages of 40 bytes, only the newest six (41 * 6 = 246 bytes) can fit.
+    for (size_t i = 0; i < 50; i++)
+    {
+        std::vector<uint8_t> msg = make_message(40, (uint8_t)i);
+        ASSERT_TRUE(circular_buffer_frame_push(&ctx, msg.data(), msg.size(), true));
+    }
+
+    ASSERT_TRUE(circular_buffer_get_overflow_count(&ctx, &overflow_count));
+    EXPECT_EQ(overflow_count, 44); // Counted in messages.
+
+    for (size_t i = 44; i < 50; i++)
+    {
+        std::vector<uint8_t> msg = make_message(40, (uint8_t)i);
+        ASSERT_TRUE(circular_buffer_frame_pop(&ctx, out.data(), out.size(), &len));
+        ASSERT_EQ(len, msg.size());
+        EXPECT_EQ(memcmp(out.data(), msg.data(), len), 0);
+    }
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferFrameTest, PeekViewSplitsAtWrapPoint)
+{
+    circular_buffer_frame_view view;
+    std::vector<uint8_t> msg = make_message(30, 9);
+
+    // Move tail near the end so the next message wraps.
+    ASSERT_TRUE(circular_buffer_commit(&ctx, buff_size - 10));
+    ASSERT_TRUE(circular_buffer_consume(&ctx, buff_size - 10));
+    ASSERT_TRUE(circular_buffer_frame_push(&ctx, msg.data(), msg.size(), false));
+
+    ASSERT_TRUE(circular_buffer_frame_peek(&ctx, &view));
+    ASSERT_EQ(view.first_len, 9); // One byte of the ten went to the header.
+    ASSERT_EQ(view.second_len, 21);
+    EXPECT_EQ(memcmp(view.first, msg.data(), view.first_len), 0);
+    EXPECT_EQ(memcmp(view.second, msg.data() + view.first_len, view.second_len), 0);
+
+    ASSERT_TRUE(circular_buffer_frame_discard(&ctx));
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_frame_peek(&ctx, &view));
+}
+
+// Records the byte count of every watermark event fired into it.
+static void record_byte_count(circular_buffer_watermark_event event, size_t byte_count, void *arg)
+{
+    (void)event;
+    ((std::vector<size_t> *)arg)->push_back(byte_count);
+}
+
+TEST_F(CircularBufferFrameTest, PushPublishesWholeFrameOnce)
+{
+    std::vector<size_t> byte_counts;
+    std::vector<uint8_t> msg = make_message(30, 3);
+
+    // Make the frame wrap, and set HIGH where the header alone would already cross it.
+    ASSERT_TRUE(circular_buffer_commit(&ctx, buff_size - 10));
+    ASSERT_TRUE(circular_buffer_consume(&ctx, buff_size - 10));
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 0, 1, record_byte_count, &byte_counts));
+    ASSERT_TRUE(circular_buffer_frame_push(&ctx, msg.data(), msg.size(), false));
+
+    // The callback saw the complete frame, not the header on its own.
+    ASSERT_EQ(byte_counts.size(), 1);
+    EXPECT_EQ(byte_counts[0], 1 + msg.size());
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferFrameTest, RejectsHeaderClaimingMoreThanStored)
+{
+    uint8_t bogus_header = 100; // Claims 100 bytes, none follow.
+    uint8_t out[128];
+    size_t len = 0;
+    circular_buffer_frame_view view;
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, bogus_header));
+    ASSERT_FALSE(circular_buffer_frame_pop(&ctx, out, sizeof(out), &len));
+    ASSERT_FALSE(circular_buffer_frame_peek(&ctx, &view));
+    ASSERT_FALSE(circular_buffer_frame_discard(&ctx));
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_mirror.h"
+}
+
+class CircularBufferMirrorTest : public ::testing::Test {
+protected:
+    size_t buff_size = 0;
+    circular_buffer_mirror_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_mirror_init(&ctx, 1));
+        buff_size = ctx.ring.buff_size;
+    }
+
+    void TearDown() override {
+        ASSERT_TRUE(circular_buffer_mirror_destroy(&ctx));
+    }
+
+    // Moves head and tail to offset so the next len bytes straddle the wrap point.
+    void advance_to(size_t offset) {
+        ASSERT_TRUE(circular_buffer_commit(&ctx.ring, offset));
+        ASSERT_TRUE(circular_buffer_consume(&ctx.ring, offset));
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferMirrorInitTest, InitHandlesInvalidArguments)
+{
+    circular_buffer_mirror_ctx ctx;
+    ASSERT_FALSE(circular_buffer_mirror_init(NULL, 4096));
+    ASSERT_FALSE(circular_buffer_mirror_init(&ctx, 0));
+    ASSERT_FALSE(circular_buffer_mirror_init(&ctx, SIZE_MAX));
+    ASSERT_FALSE(circular_buffer_mirror_destroy(NULL));
+}
+
+TEST(CircularBufferMirrorInitTest, InitRoundsUpToWholePages)
+{
+    circular_buffer_mirror_ctx ctx;
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    ASSERT_TRUE(circular_buffer_mirror_init(&ctx, page_size + 1));
+    EXPECT_EQ(ctx.ring.buff_size, 2 * page_size);
+    ASSERT_TRUE(circular_buffer_mirror_destroy(&ctx));
+    ASSERT_FALSE(circular_buffer_mirror_destroy(&ctx));
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferMirrorTest, HandlesNullArguments)
+{
+    const uint8_t *data = NULL;
+    uint8_t *space = NULL;
+    size_t len = 0;
+    ASSERT_FALSE(circular_buffer_mirror_peek(NULL, &data, &len));
+    ASSERT_FALSE(circular_buffer_mirror_peek(&ctx, NULL, &len));
+    ASSERT_FALSE(circular_buffer_mirror_peek(&ctx, &data, NULL));
+    ASSERT_FALSE(circular_buffer_mirror_reserve(NULL, &space, &len));
+    ASSERT_FALSE(circular_buffer_mirror_reserve(&ctx, NULL, &len));
+    ASSERT_FALSE(circular_buffer_mirror_reserve(&ctx, &space, NULL));
+    ASSERT_FALSE(circular_buffer_mirror_commit(NULL, 1));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferMirrorTest, MappingsAliasTheSamePages)
+{
+    ctx.mapping[3] = 0x5A;
+    EXPECT_EQ(ctx.mapping[buff_size + 3], 0x5A);
+    ctx.mapping[buff_size + buff_size - 1] = 0xA5;
+    EXPECT_EQ(ctx.mapping[buff_size - 1], 0xA5);
+}
+
+TEST_F(CircularBufferMirrorTest, KeepsRegularPushPopSemantics)
+{
+    uint8_t data_out = 0;
+
+    advance_to(buff_size - 2);
+    for (size_t i = 0; i < 5; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx.ring, (uint8_t)(i + 1)));
+    }
+    ASSERT_TRUE(circular_buffer_peek(&ctx.ring, &data_out));
+    EXPECT_EQ(data_out, 1);
+    for (size_t i = 0; i < 5; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pop(&ctx.ring, &data_out));
+        EXPECT_EQ(data_out, (uint8_t)(i + 1));
+    }
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx.ring));
+}
+
+TEST_F(CircularBufferMirrorTest, PeekIsContiguousAcrossWrapPoint)
+{
+    const char msg[] = "hello,\nworld";
+    const uint8_t *data = NULL;
+    size_t len = 0;
+
+    ASSERT_FALSE(circular_buffer_mirror_peek(&ctx, &data, &len));
+
+    advance_to(buff_size - 4);
+    ASSERT_TRUE(circular_buffer_write(&ctx.ring, (const uint8_t *)msg, sizeof(msg), false));
+
+    ASSERT_TRUE(circular_buffer_mirror_peek(&ctx, &data, &len));
+    ASSERT_EQ(len, sizeof(msg));
+    EXPECT_EQ(memcmp(data, msg, sizeof(msg)), 0);
+    EXPECT_EQ(memchr(data, '\n', len), data + 6);
+
+    ASSERT_TRUE(circular_buffer_consume(&ctx.ring, len));
+    ASSERT_FALSE(circular_buffer_mirror_peek(&ctx, &data, &len));
+}
+
+TEST_F(CircularBufferMirrorTest, ReserveIsContiguousAcrossWrapPoint)
+{
+    std::vector<uint8_t> out(buff_size);
+    uint8_t *space = NULL;
+    size_t len = 0;
+
+    advance_to(buff_size / 2);
+    ASSERT_TRUE(circular_buffer_mirror_reserve(&ctx, &space, &len));
+    ASSERT_EQ(len, buff_size);
+
+    // One fill of the whole buffer, half of it landing in the mirror.
+    for (size_t i = 0; i < len; i++)
+    {
+        space[i] = (uint8_t)i;
+    }
+    // The ring alone only publishes up to the end of storage.
+    ASSERT_FALSE(circular_buffer_commit(&ctx.ring, len));
+    ASSERT_TRUE(circular_buffer_mirror_commit(&ctx, len));
+    ASSERT_TRUE(circular_buffer_is_full(&ctx.ring));
+    ASSERT_FALSE(circular_buffer_mirror_reserve(&ctx, &space, &len));
+
+    ASSERT_TRUE(circular_buffer_read(&ctx.ring, out.data(), buff_size));
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_EQ(out[i], (uint8_t)i);
+    }
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_mpmc.h"
+}
+
+class CircularBufferMpmcTest : public ::testing::Test {
+protected:
+    size_t buff_size = 256;
+    std::vector<circular_buffer_mpmc_slot> slots = std::vector<circular_buffer_mpmc_slot>(buff_size);  // Caller storage works in every build
+    circular_buffer_mpmc_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_mpmc_init_with_storage(&ctx, slots.data(), slots.size()));
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferMpmcInitTest, InitHandlesNULLCtx)
+{
+    ASSERT_FALSE(circular_buffer_mpmc_init(NULL, 256));
+}
+
+TEST(CircularBufferMpmcInitTest, InitRequiresPowerOfTwoSize)
+{
+    circular_buffer_mpmc_ctx ctx;
+    ASSERT_FALSE(circular_buffer_mpmc_init(&ctx, 0));
+    ASSERT_FALSE(circular_buffer_mpmc_init(&ctx, 3));
+    ASSERT_FALSE(circular_buffer_mpmc_init(&ctx, 100));
+#if CIRCULAR_BUFFER_MAX_SIZE >= 64
+    ASSERT_TRUE(circular_buffer_mpmc_init(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_mpmc_init(&ctx, 64));
+#endif
+}
+
+TEST(CircularBufferMpmcInitTest, InitDoesNotAllowBuffSizeGreaterThanMax)
+{
+    circular_buffer_mpmc_ctx ctx;
+    ASSERT_FALSE(circular_buffer_mpmc_init(&ctx, 2 * CIRCULAR_BUFFER_MAX_SIZE));
+}
+
+TEST(CircularBufferMpmcInitTest, InitWithStorageUsesCallerSlots)
+{
+    circular_buffer_mpmc_ctx ctx;
+    circular_buffer_mpmc_slot slots[4];
+    uint8_t data_out = 0;
+
+    ASSERT_FALSE(circular_buffer_mpmc_init_with_storage(NULL, slots, 4));
+    ASSERT_FALSE(circular_buffer_mpmc_init_with_storage(&ctx, NULL, 4));
+    ASSERT_FALSE(circular_buffer_mpmc_init_with_storage(&ctx, slots, 0));
+    ASSERT_FALSE(circular_buffer_mpmc_init_with_storage(&ctx, slots, 3));
+    ASSERT_TRUE(circular_buffer_mpmc_init_with_storage(&ctx, slots, 4));
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(circular_buffer_mpmc_push(&ctx, (uint8_t)(i + 1)));
+        EXPECT_EQ(slots[i].data, (uint8_t)(i + 1));
+    }
+    ASSERT_TRUE(circular_buffer_mpmc_is_full(&ctx));
+    ASSERT_TRUE(circular_buffer_mpmc_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 1);
+}
+
+TEST(CircularBufferMpmcInitTest, EmbeddedStorageRejectsCorruptSizeGreaterThanMax)
+{
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    circular_buffer_mpmc_ctx ctx;
+    uint8_t data_out = 0;
+    size_t corrupt_size = 1;
+
+    while (corrupt_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        corrupt_size *= 2;
+    }
+    ASSERT_TRUE(circular_buffer_mpmc_init(&ctx, 1));
+
+    // A power of two, but would index past the embedded slots.
+    ctx.buff_size = corrupt_size;
+    ASSERT_FALSE(circular_buffer_mpmc_push(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_mpmc_pop(&ctx, &data_out));
+#else
+    GTEST_SKIP() << "No embedded storage, CIRCULAR_BUFFER_MAX_SIZE is 0";
+#endif
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferMpmcTest, HandlesNullArguments)
+{
+    uint8_t data = 0;
+    ASSERT_FALSE(circular_buffer_mpmc_push(NULL, data));
+    ASSERT_FALSE(circular_buffer_mpmc_pop(NULL, &data));
+    ASSERT_FALSE(circular_buffer_mpmc_pop(&ctx, NULL));
+    ASSERT_TRUE(circular_buffer_mpmc_is_empty(NULL));
+    ASSERT_FALSE(circular_buffer_mpmc_is_full(NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferMpmcTest, PushPopData)
+{
+    uint8_t data_out = 0;
+    ASSERT_TRUE(circular_buffer_mpmc_is_empty(&ctx));
+    ASSERT_TRUE(circular_buffer_mpmc_push(&ctx, 42));
+    ASSERT_FALSE(circular_buffer_mpmc_is_empty(&ctx));
+    ASSERT_TRUE(circular_buffer_mpmc_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 42);
+    ASSERT_TRUE(circular_buffer_mpmc_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_mpmc_pop(&ctx, &data_out));
+}
+
+TEST_F(CircularBufferMpmcTest, PushFailsForFullBufferWithoutOverwriting)
+{
+    uint8_t data_out = 0;
+
+    // Run several laps so every slot's sequence number advances more than once.
+    for (size_t lap = 0; lap < 5; lap++)
+    {
+        for (size_t i = 0; i < buff_size; i++)
+        {
+            ASSERT_TRUE(circular_buffer_mpmc_push(&ctx, (uint8_t)(i + lap)));
+        }
+        ASSERT_TRUE(circular_buffer_mpmc_is_full(&ctx));
+        ASSERT_FALSE(circular_buffer_mpmc_push(&ctx, 0xFF));
+
+        for (size_t i = 0; i < buff_size; i++)
+        {
+            ASSERT_TRUE(circular_buffer_mpmc_pop(&ctx, &data_out));
+            EXPECT_EQ(data_out, (uint8_t)(i + lap));
+        }
+        ASSERT_TRUE(circular_buffer_mpmc_is_empty(&ctx));
+        ASSERT_FALSE(circular_buffer_mpmc_is_full(&ctx));
+    }
+}
+
+/****************** SECTION: Concurrency ************************/
+
+TEST_F(CircularBufferMpmcTest, MultiProducerMultiConsumerStressTest)
+{
+    const size_t producer_count = 4;
+    const size_t consumer_count = 4;
+    const size_t bytes_per_producer = 200000;
+    std::vector<std::vector<size_t>> received(consumer_count, std::vector<size_t>(producer_count, 0));
+    std::vector<std::thread> threads;
+
+    // Each producer pushes its own id, so every byte can be traced back to its sender.
+    for (size_t p = 0; p < producer_count; p++)
+    {
+        threads.emplace_back([&, p]() {
+            for (size_t i = 0; i < bytes_per_producer; i++)
+            {
+                while (!circular_buffer_mpmc_push(&ctx, (uint8_t)p))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Consumers split the total between them and tally what they see.
+    for (size_t c = 0; c < consumer_count; c++)
+    {
+        threads.emplace_back([&, c]() {
+            size_t share = (producer_count * bytes_per_producer) / consumer_count;
+            for (size_t i = 0; i < share; i++)
+            {
+                uint8_t data_out = 0;
+                while (!circular_buffer_mpmc_pop(&ctx, &data_out))
+                {
+                    std::this_thread::yield();
+                }
+                if (data_out < producer_count)
+                {
+                    received[c][data_out]++;
+                }
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every byte arrives exactly once.
+    for (size_t p = 0; p < producer_count; p++)
+    {
+        size_t total = 0;
+        for (size_t c = 0; c < consumer_count; c++)
+        {
+            total += received[c][p];
+        }
+        EXPECT_EQ(total, bytes_per_producer);
+    }
+    ASSERT_TRUE(circular_buffer_mpmc_is_empty(&ctx));
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferMpmcTest, ProtectsAgainstCorruptCtx)
+{
+    uint8_t data_out = 0;
+    circular_buffer_mpmc_ctx corrupt_ctx = ctx;
+    corrupt_ctx.buff_size = 3; // not a power of two
+    ASSERT_FALSE(circular_buffer_mpmc_push(&corrupt_ctx, 0));
+    ASSERT_FALSE(circular_buffer_mpmc_pop(&corrupt_ctx, &data_out));
+    corrupt_ctx.slots = NULL;
+    corrupt_ctx.buff_size = buff_size;
+    ASSERT_FALSE(circular_buffer_mpmc_push(&corrupt_ctx, 0));
+}
@@ -0,0 +1,217 @@
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_persist.h"
+}
+
+class CircularBufferPersistTest : public ::testing::Test {
+protected:
+    size_t buff_size = 256;
+    std::string path;
+    circular_buffer_persist_ctx ctx;
+
+    void SetUp() override {
+        char name[] = "/tmp/circular_buffer_persist_XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        (void)close(fd);
+        path = name;
+        ASSERT_TRUE(circular_buffer_persist_create(&ctx, path.c_str(), buff_size));
+    }
+
+    void TearDown() override {
+        (void)circular_buffer_persist_close(&ctx);
+        (void)unlink(path.c_str());
+    }
+
+    // Closes and recovers the file, as a restarted process would.
+    void restart() {
+        ASSERT_TRUE(circular_buffer_persist_close(&ctx));
+        ASSERT_TRUE(circular_buffer_persist_recover(&ctx, path.c_str()));
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferPersistInitTest, HandlesInvalidArguments)
+{
+    circular_buffer_persist_ctx ctx;
+
+    ASSERT_FALSE(circular_buffer_persist_create(NULL, "/tmp/unused", 16));
+    EXPECT_EQ(errno, EINVAL);
+    ASSERT_FALSE(circular_buffer_persist_create(&ctx, NULL, 16));
+    ASSERT_FALSE(circular_buffer_persist_create(&ctx, "/tmp/unused", 0));
+    ASSERT_FALSE(circular_buffer_persist_recover(NULL, "/tmp/unused"));
+    ASSERT_FALSE(circular_buffer_persist_recover(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_persist_sync(NULL));
+    ASSERT_FALSE(circular_buffer_persist_close(NULL));
+}
+
+TEST(CircularBufferPersistInitTest, RecoverFailsForMissingFile)
+{
+    circular_buffer_persist_ctx ctx;
+
+    ASSERT_FALSE(circular_buffer_persist_recover(&ctx, "/tmp/circular_buffer_persist_does_not_exist"));
+    EXPECT_EQ(errno, ENOENT);
+}
+
+TEST_F(CircularBufferPersistTest, CreateStartsEmptyWithVersionedHeader)
+{
+    const circular_buffer_persist_header *header = (const circular_buffer_persist_header *)ctx.mapping;
+
+    EXPECT_EQ(header->magic, CIRCULAR_BUFFER_PERSIST_MAGIC);
+    EXPECT_EQ(header->version, CIRCULAR_BUFFER_PERSIST_VERSION);
+    EXPECT_EQ(header->ctx_size, sizeof(circular_buffer_ctx));
+    EXPECT_EQ(header->storage_size, buff_size);
+    EXPECT_EQ(ctx.ring->buff_size, buff_size);
+    EXPECT_EQ(ctx.ring->buffer, ctx.mapping + header->storage_offset);
+    ASSERT_TRUE(circular_buffer_is_empty(ctx.ring));
+}
+
+/****************** SECTION: Recovery ************************/
+
+TEST_F(CircularBufferPersistTest, RecoverReattachesToStoredData)
+{
+    std::vector<uint8_t> block(buff_size);
+    std::vector<uint8_t> out(buff_size);
+    uint32_t overflow_count = 0;
+
+    // Wrap the indices and overflow, so head, tail and the counters are all non-trivial.
+    for (size_t i = 0; i < block.size(); i++)
+    {
+        block[i] = (uint8_t)(i * 7);
+    }
+    ASSERT_TRUE(circular_buffer_write(ctx.ring, block.data(), 100, false));
+    ASSERT_TRUE(circular_buffer_consume(ctx.ring, 100));
+    ASSERT_TRUE(circular_buffer_write(ctx.ring, block.data(), buff_size, false));
+    ASSERT_TRUE(circular_buffer_push_with_overwrite(ctx.ring, 0xAA));
+
+    restart();
+
+    ASSERT_TRUE(circular_buffer_get_overflow_count(ctx.ring, &overflow_count));
+    EXPECT_EQ(overflow_count, 1);
+    ASSERT_TRUE(circular_buffer_read(ctx.ring, out.data(), buff_size));
+    EXPECT_EQ(memcmp(out.data(), block.data() + 1, buff_size - 1), 0);
+    EXPECT_EQ(out[buff_size - 1], 0xAA);
+    ASSERT_TRUE(circular_buffer_is_empty(ctx.ring));
+}
+
+TEST_F(CircularBufferPersistTest, RecoverClearsCallbacksFromPreviousProcess)
+{
+    ASSERT_TRUE(circular_buffer_set_watermarks(ctx.ring, 1, 2, [](circular_buffer_watermark_event, size_t, void *) {},
+                                               NULL));
+    restart();
+    EXPECT_EQ(ctx.ring->watermark_cb, nullptr);
+    ASSERT_TRUE(circular_buffer_write(ctx.ring, (const uint8_t *)"abc", 3, false));
+}
+
+TEST_F(CircularBufferPersistTest, SyncSucceeds)
+{
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(ctx.ring, 1));
+    ASSERT_TRUE(circular_buffer_persist_sync(&ctx));
+}
+
+TEST_F(CircularBufferPersistTest, DataSurvivesProcessCrash)
+{
+    // Hand the file over to the child.
+    ASSERT_TRUE(circular_buffer_persist_close(&ctx));
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+
+    if (pid == 0)
+    {
+        // The child writes and dies without closing or syncing anything.
+        circular_buffer_persist_ctx child;
+        bool ok = circular_buffer_persist_recover(&child, path.c_str()) &&
+                  circular_buffer_write(child.ring, (const uint8_t *)"last words", 10, false);
+        _exit(ok ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // The child's death released the lock.
+    ASSERT_TRUE(circular_buffer_persist_recover(&ctx, path.c_str()));
+    uint8_t out[10];
+    ASSERT_TRUE(circular_buffer_read(ctx.ring, out, sizeof(out)));
+    EXPECT_EQ(memcmp(out, "last words", sizeof(out)), 0);
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferPersistTest, SecondHandleFailsWhileFileIsOpen)
+{
+    circular_buffer_persist_ctx other;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(ctx.ring, 0x5A));
+
+    ASSERT_FALSE(circular_buffer_persist_recover(&other, path.c_str()));
+    EXPECT_EQ(errno, EWOULDBLOCK);
+    ASSERT_FALSE(circular_buffer_persist_close(&other));
+    ASSERT_FALSE(circular_buffer_persist_create(&other, path.c_str(), buff_size));
+    EXPECT_EQ(errno, EWOULDBLOCK);
+
+    // The live handle is untouched: same storage, same data, still usable.
+    EXPECT_EQ(ctx.ring->buffer, ctx.mapping + ((circular_buffer_persist_header *)ctx.mapping)->storage_offset);
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(ctx.ring, 0xA5));
+    ASSERT_TRUE(circular_buffer_pop(ctx.ring, &data_out));
+    EXPECT_EQ(data_out, 0x5A);
+
+    // Once closed, the file can be recovered.
+    restart();
+    ASSERT_TRUE(circular_buffer_pop(ctx.ring, &data_out));
+    EXPECT_EQ(data_out, 0xA5);
+}
+
+TEST_F(CircularBufferPersistTest, RecoverRejectsBadHeader)
+{
+    circular_buffer_persist_header *header = (circular_buffer_persist_header *)ctx.mapping;
+
+    header->version = CIRCULAR_BUFFER_PERSIST_VERSION + 1;
+    ASSERT_TRUE(circular_buffer_persist_close(&ctx));
+    ASSERT_FALSE(circular_buffer_persist_recover(&ctx, path.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+
+    ASSERT_TRUE(circular_buffer_persist_create(&ctx, path.c_str(), buff_size));
+    header = (circular_buffer_persist_header *)ctx.mapping;
+    header->magic = 0;
+    ASSERT_TRUE(circular_buffer_persist_close(&ctx));
+    ASSERT_FALSE(circular_buffer_persist_recover(&ctx, path.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+}
+
+TEST_F(CircularBufferPersistTest, RecoverRejectsTruncatedFile)
+{
+    ASSERT_TRUE(circular_buffer_persist_close(&ctx));
+    ASSERT_EQ(truncate(path.c_str(), 8), 0);
+    ASSERT_FALSE(circular_buffer_persist_recover(&ctx, path.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+}
+
+TEST_F(CircularBufferPersistTest, RecoverRejectsInconsistentIndices)
+{
+    // As if the writer died between moving head and updating the count.
+    ASSERT_TRUE(circular_buffer_write(ctx.ring, (const uint8_t *)"abc", 3, false));
+    ctx.ring->head = 4;
+    ASSERT_TRUE(circular_buffer_persist_close(&ctx));
+    ASSERT_FALSE(circular_buffer_persist_recover(&ctx, path.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+
+    ASSERT_TRUE(circular_buffer_persist_create(&ctx, path.c_str(), buff_size));
+    ctx.ring->current_byte_count = buff_size + 1;
+    ASSERT_TRUE(circular_buffer_persist_close(&ctx));
+    ASSERT_FALSE(circular_buffer_persist_recover(&ctx, path.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+}
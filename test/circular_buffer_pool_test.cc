@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_pool.h"
+}
+
+class CircularBufferPoolTest : public ::testing::Test {
+protected:
+    const size_t block_sizes[3] = { 64, 256, 1024 };
+    const size_t block_counts[3] = { 4, 2, 1 };
+    std::vector<uint8_t> arena = std::vector<uint8_t>(4 * 64 + 2 * 256 + 1024);
+    circular_buffer_pool pool;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_pool_init(&pool, arena.data(), arena.size(), block_sizes, block_counts, 3));
+    }
+
+    size_t in_use(size_t class_index) {
+        circular_buffer_pool_usage usage;
+        EXPECT_TRUE(circular_buffer_pool_get_usage(&pool, class_index, &usage));
+        return usage.in_use;
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferPoolInitTest, InitRejectsInvalidArguments)
+{
+    circular_buffer_pool pool;
+    uint8_t arena[256];
+    const size_t sizes[2] = { 32, 64 };
+    const size_t counts[2] = { 2, 2 };
+    const size_t descending[2] = { 64, 32 };
+    const size_t too_small[1] = { 1 };
+    const size_t none[1] = { 0 };
+
+    ASSERT_FALSE(circular_buffer_pool_init(NULL, arena, sizeof(arena), sizes, counts, 2));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, NULL, sizeof(arena), sizes, counts, 2));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, sizeof(arena), NULL, counts, 2));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, sizeof(arena), sizes, NULL, 2));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, sizeof(arena), sizes, counts, 0));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, sizeof(arena), sizes, counts,
+                                           CIRCULAR_BUFFER_POOL_MAX_CLASSES + 1));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, sizeof(arena), descending, counts, 2));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, sizeof(arena), too_small, counts, 1));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, sizeof(arena), sizes, none, 1));
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, 191, sizes, counts, 2));
+    ASSERT_TRUE(circular_buffer_pool_init(&pool, arena, 192, sizes, counts, 2));
+}
+
+TEST(CircularBufferPoolInitTest, InitRejectsSizesThatOverflow)
+{
+    circular_buffer_pool pool;
+    uint8_t arena[64];
+    const size_t sizes[2] = { 16, SIZE_MAX / 2 };
+    const size_t counts[2] = { 1, 3 };
+
+    ASSERT_FALSE(circular_buffer_pool_init(&pool, arena, SIZE_MAX, sizes, counts, 2));
+}
+
+TEST_F(CircularBufferPoolTest, InitReportsEmptyClasses)
+{
+    circular_buffer_pool_usage usage;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pool_get_usage(&pool, i, &usage));
+        EXPECT_EQ(usage.block_size, block_sizes[i]);
+        EXPECT_EQ(usage.block_count, block_counts[i]);
+        EXPECT_EQ(usage.in_use, 0);
+        EXPECT_EQ(usage.high_water, 0);
+    }
+    ASSERT_FALSE(circular_buffer_pool_get_usage(&pool, 3, &usage));
+    ASSERT_FALSE(circular_buffer_pool_get_usage(&pool, 0, NULL));
+    ASSERT_FALSE(circular_buffer_pool_get_usage(NULL, 0, &usage));
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferPoolTest, HandlesNullArguments)
+{
+    circular_buffer_ctx ctx;
+    ASSERT_FALSE(circular_buffer_pool_acquire(NULL, &ctx, 1));
+    ASSERT_FALSE(circular_buffer_pool_acquire(&pool, NULL, 1));
+    ASSERT_FALSE(circular_buffer_pool_acquire(&pool, &ctx, 0));
+    ASSERT_FALSE(circular_buffer_pool_release(NULL, &ctx));
+    ASSERT_FALSE(circular_buffer_pool_release(&pool, NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferPoolTest, AcquirePicksSmallestFittingClass)
+{
+    circular_buffer_ctx small;
+    circular_buffer_ctx medium;
+    circular_buffer_ctx large;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &small, 10));
+    ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &medium, 65));
+    ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &large, 1024));
+    EXPECT_EQ(small.buff_size, 64);
+    EXPECT_EQ(medium.buff_size, 256);
+    EXPECT_EQ(large.buff_size, 1024);
+    EXPECT_EQ(in_use(0), 1);
+    EXPECT_EQ(in_use(1), 1);
+    EXPECT_EQ(in_use(2), 1);
+
+    // Each is an ordinary buffer over its own block.
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&small, 1));
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&medium, 2));
+    ASSERT_TRUE(circular_buffer_pop(&small, &data_out));
+    EXPECT_EQ(data_out, 1);
+    ASSERT_TRUE(circular_buffer_pop(&medium, &data_out));
+    EXPECT_EQ(data_out, 2);
+
+    circular_buffer_ctx too_big;
+    ASSERT_FALSE(circular_buffer_pool_acquire(&pool, &too_big, 1025));
+}
+
+TEST_F(CircularBufferPoolTest, AcquireFallsBackToLargerClassWhenExhausted)
+{
+    std::vector<circular_buffer_ctx> rings(7);
+
+    for (size_t i = 0; i < rings.size(); i++)
+    {
+        ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &rings[i], 1));
+    }
+    EXPECT_EQ(rings[3].buff_size, 64);
+    EXPECT_EQ(rings[4].buff_size, 256);
+    EXPECT_EQ(rings[6].buff_size, 1024);
+
+    circular_buffer_ctx none_left;
+    ASSERT_FALSE(circular_buffer_pool_acquire(&pool, &none_left, 1));
+}
+
+TEST_F(CircularBufferPoolTest, ReleasedBlocksAreReused)
+{
+    circular_buffer_ctx rings[4];
+    circular_buffer_pool_usage usage;
+
+    for (circular_buffer_ctx &ring : rings)
+    {
+        ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &ring, 64));
+    }
+    uint8_t *released = rings[2].buffer;
+    ASSERT_TRUE(circular_buffer_pool_release(&pool, &rings[2]));
+    ASSERT_TRUE(circular_buffer_pool_release(&pool, &rings[0]));
+    EXPECT_EQ(in_use(0), 2);
+
+    // Last released, first reused.
+    circular_buffer_ctx again;
+    ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &again, 64));
+    ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &rings[2], 64));
+    EXPECT_EQ(rings[2].buffer, released);
+
+    ASSERT_TRUE(circular_buffer_pool_get_usage(&pool, 0, &usage));
+    EXPECT_EQ(usage.in_use, 4);
+    EXPECT_EQ(usage.high_water, 4);
+}
+
+TEST_F(CircularBufferPoolTest, BlocksDoNotOverlap)
+{
+    std::vector<circular_buffer_ctx> rings(7);
+
+    for (size_t i = 0; i < rings.size(); i++)
+    {
+        ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &rings[i], 1));
+        std::vector<uint8_t> fill(rings[i].buff_size, (uint8_t)i);
+        ASSERT_TRUE(circular_buffer_write(&rings[i], fill.data(), fill.size(), false));
+    }
+
+    for (size_t i = 0; i < rings.size(); i++)
+    {
+        ASSERT_GE(rings[i].buffer, arena.data());
+        ASSERT_LE(rings[i].buffer + rings[i].buff_size, arena.data() + arena.size());
+        std::vector<uint8_t> out(rings[i].buff_size);
+        ASSERT_TRUE(circular_buffer_read(&rings[i], out.data(), out.size()));
+        EXPECT_EQ(out, std::vector<uint8_t>(out.size(), (uint8_t)i));
+    }
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferPoolTest, ReleaseRejectsForeignOrReleasedBuffers)
+{
+    circular_buffer_ctx ring;
+    circular_buffer_ctx foreign;
+    uint8_t storage[64];
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_init_with_storage(&foreign, storage, sizeof(storage)));
+    ASSERT_FALSE(circular_buffer_pool_release(&pool, &foreign));
+
+    // Inside the arena but not at a block boundary.
+    ASSERT_TRUE(circular_buffer_init_with_storage(&foreign, arena.data() + 1, 64));
+    ASSERT_FALSE(circular_buffer_pool_release(&pool, &foreign));
+
+    ASSERT_TRUE(circular_buffer_pool_acquire(&pool, &ring, 1));
+    ASSERT_TRUE(circular_buffer_pool_release(&pool, &ring));
+    ASSERT_FALSE(circular_buffer_pool_release(&pool, &ring));
+    ASSERT_FALSE(circular_buffer_pop(&ring, &data_out));
+    EXPECT_EQ(in_use(0), 0);
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_pow2.h"
+}
+
+class CircularBufferPow2Test : public ::testing::Test {
+protected:
+    size_t buff_size = 256;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(buff_size);  // Caller storage works in every build
+    circular_buffer_pow2_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_pow2_init_with_storage(&ctx, storage.data(), storage.size()));
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferPow2InitTest, InitHandlesNULLCtx)
+{
+    ASSERT_FALSE(circular_buffer_pow2_init(NULL, 256));
+}
+
+TEST(CircularBufferPow2InitTest, InitOnlyAllowsPowersOfTwoUpToMax)
+{
+#if CIRCULAR_BUFFER_MAX_SIZE >= 64
+    circular_buffer_pow2_ctx ctx;
+    ASSERT_FALSE(circular_buffer_pow2_init(&ctx, 0));
+    ASSERT_FALSE(circular_buffer_pow2_init(&ctx, 3));
+    ASSERT_FALSE(circular_buffer_pow2_init(&ctx, 100));
+    ASSERT_FALSE(circular_buffer_pow2_init(&ctx, CIRCULAR_BUFFER_MAX_SIZE * 2));
+    ASSERT_TRUE(circular_buffer_pow2_init(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_pow2_init(&ctx, 64));
+#else
+    GTEST_SKIP() << "Embedded storage smaller than 64 bytes";
+#endif
+}
+
+TEST(CircularBufferPow2InitTest, InitWithStorageAllowsPowerOfTwoGreaterThanMax)
+{
+    circular_buffer_pow2_ctx ctx;
+    size_t buff_size = 64;
+    while (buff_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        buff_size *= 2;
+    }
+    std::vector<uint8_t> storage(buff_size);
+    uint8_t data_out = 0;
+
+    ASSERT_FALSE(circular_buffer_pow2_init_with_storage(&ctx, NULL, buff_size));
+    ASSERT_FALSE(circular_buffer_pow2_init_with_storage(&ctx, storage.data(), buff_size - 1));
+    ASSERT_TRUE(circular_buffer_pow2_init_with_storage(&ctx, storage.data(), buff_size));
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pow2_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_TRUE(circular_buffer_pow2_is_full(&ctx));
+    EXPECT_EQ(storage[buff_size - 1], (uint8_t)(buff_size - 1));
+    ASSERT_TRUE(circular_buffer_pow2_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 0);
+}
+
+TEST(CircularBufferPow2InitTest, EmbeddedStorageRejectsCorruptSizeGreaterThanMax)
+{
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    circular_buffer_pow2_ctx ctx;
+    uint8_t data_out = 0;
+    size_t corrupt_size = 1;
+
+    while (corrupt_size <= CIRCULAR_BUFFER_MAX_SIZE)
+    {
+        corrupt_size *= 2;
+    }
+    ASSERT_TRUE(circular_buffer_pow2_init(&ctx, 1));
+
+    // A power of two, but would index past the embedded array.
+    ctx.buff_size = corrupt_size;
+    ASSERT_FALSE(circular_buffer_pow2_push_no_overwrite(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_pow2_pop(&ctx, &data_out));
+#else
+    GTEST_SKIP() << "No embedded storage, CIRCULAR_BUFFER_MAX_SIZE is 0";
+#endif
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferPow2Test, HandlesNullArguments)
+{
+    uint8_t data = 0;
+    size_t capacity = 0;
+    uint32_t overflow_count = 0;
+    ASSERT_FALSE(circular_buffer_pow2_push_with_overwrite(NULL, data));
+    ASSERT_FALSE(circular_buffer_pow2_push_no_overwrite(NULL, data));
+    ASSERT_FALSE(circular_buffer_pow2_pop(NULL, &data));
+    ASSERT_FALSE(circular_buffer_pow2_pop(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_pow2_peek(NULL, &data));
+    ASSERT_FALSE(circular_buffer_pow2_peek(&ctx, NULL));
+    ASSERT_TRUE(circular_buffer_pow2_is_empty(NULL));
+    ASSERT_FALSE(circular_buffer_pow2_is_full(NULL));
+    ASSERT_FALSE(circular_buffer_pow2_get_current_capacity(NULL, &capacity));
+    ASSERT_FALSE(circular_buffer_pow2_get_current_capacity(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_pow2_get_overflow_count(NULL, &overflow_count));
+    ASSERT_FALSE(circular_buffer_pow2_get_overflow_count(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_pow2_clear_overflow_count(NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferPow2Test, PushPopMatchesModuloBuffer)
+{
+    circular_buffer_ctx modulo_ctx;
+    std::vector<uint8_t> modulo_storage(buff_size);
+    ASSERT_TRUE(circular_buffer_init_with_storage(&modulo_ctx, modulo_storage.data(), buff_size));
+
+    // Same random traffic through both, including overwrites.
+    for (size_t i = 0; i < 20 * buff_size; i++)
+    {
+        uint8_t data_in = (uint8_t)(rand() % 256);
+        if (rand() % 3 != 0)
+        {
+            ASSERT_TRUE(circular_buffer_pow2_push_with_overwrite(&ctx, data_in));
+            ASSERT_TRUE(circular_buffer_push_with_overwrite(&modulo_ctx, data_in));
+        }
+        else
+        {
+            uint8_t data_out = 0, modulo_data_out = 0;
+            bool popped = circular_buffer_pop(&modulo_ctx, &modulo_data_out);
+            ASSERT_EQ(circular_buffer_pow2_pop(&ctx, &data_out), popped);
+            EXPECT_EQ(data_out, modulo_data_out);
+        }
+    }
+
+    uint32_t overflow_count = 0, modulo_overflow_count = 0;
+    ASSERT_TRUE(circular_buffer_pow2_get_overflow_count(&ctx, &overflow_count));
+    ASSERT_TRUE(circular_buffer_get_overflow_count(&modulo_ctx, &modulo_overflow_count));
+    EXPECT_EQ(overflow_count, modulo_overflow_count);
+    EXPECT_EQ(circular_buffer_pow2_is_full(&ctx), circular_buffer_is_full(&modulo_ctx));
+
+    ASSERT_TRUE(circular_buffer_pow2_clear_overflow_count(&ctx));
+    ASSERT_TRUE(circular_buffer_pow2_get_overflow_count(&ctx, &overflow_count));
+    EXPECT_EQ(overflow_count, 0);
+}
+
+TEST_F(CircularBufferPow2Test, PushNoOverwriteFailsForFullBuffer)
+{
+    uint8_t data_out = 0;
+    size_t capacity = 0;
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pow2_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_TRUE(circular_buffer_pow2_is_full(&ctx));
+    ASSERT_FALSE(circular_buffer_pow2_push_no_overwrite(&ctx, 0xFF));
+    ASSERT_TRUE(circular_buffer_pow2_get_current_capacity(&ctx, &capacity));
+    EXPECT_EQ(capacity, 0);
+
+    ASSERT_TRUE(circular_buffer_pow2_peek(&ctx, &data_out));
+    EXPECT_EQ(data_out, 0);
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pow2_pop(&ctx, &data_out));
+        EXPECT_EQ(data_out, (uint8_t)i);
+    }
+    ASSERT_TRUE(circular_buffer_pow2_is_empty(&ctx));
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferPow2Test, FreeRunningIndicesSurviveRollover)
+{
+    uint8_t data_out = 0;
+
+    // Start just short of the size_t rollover.
+    ctx.head = SIZE_MAX - 10;
+    ctx.tail = SIZE_MAX - 10;
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pow2_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_TRUE(circular_buffer_pow2_is_full(&ctx));
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pow2_pop(&ctx, &data_out));
+        EXPECT_EQ(data_out, (uint8_t)i);
+    }
+    ASSERT_TRUE(circular_buffer_pow2_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferPow2Test, ProtectsAgainstCorruptCtx)
+{
+    uint8_t data_out = 0;
+    circular_buffer_pow2_ctx corrupt_ctx = ctx;
+    corrupt_ctx.head = corrupt_ctx.tail + buff_size + 1; // more bytes than fit
+    ASSERT_FALSE(circular_buffer_pow2_push_with_overwrite(&corrupt_ctx, 0));
+    ASSERT_FALSE(circular_buffer_pow2_pop(&corrupt_ctx, &data_out));
+
+    corrupt_ctx = ctx;
+    corrupt_ctx.buff_size = 100; // not a power of two
+    ASSERT_FALSE(circular_buffer_pow2_push_no_overwrite(&corrupt_ctx, 0));
+    ASSERT_FALSE(circular_buffer_pow2_peek(&corrupt_ctx, &data_out));
+}
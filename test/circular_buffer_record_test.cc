@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_record.h"
+}
+
+// A typical fixed-size record, e.g. a CAN frame.
+struct test_frame {
+    uint32_t id;
+    uint8_t len;
+    uint8_t data[8];
+};
+
+class CircularBufferRecordTest : public ::testing::Test {
+protected:
+    size_t elem_count = 16;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(sizeof(test_frame) * elem_count);  // Caller storage works in every build
+    circular_buffer_record_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_record_init_with_storage(&ctx, sizeof(test_frame), storage.data(), storage.size()));
+    }
+
+    static test_frame make_frame(uint32_t id) {
+        test_frame frame = {};
+        frame.id = id;
+        frame.len = 8;
+        for (size_t i = 0; i < sizeof(frame.data); i++)
+        {
+            frame.data[i] = (uint8_t)(id + i);
+        }
+        return frame;
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferRecordInitTest, InitRejectsInvalidSizes)
+{
+    circular_buffer_record_ctx ctx;
+    ASSERT_FALSE(circular_buffer_record_init(NULL, 4, 4));
+    ASSERT_FALSE(circular_buffer_record_init(&ctx, 0, 4));
+    ASSERT_FALSE(circular_buffer_record_init(&ctx, 4, 0));
+    ASSERT_FALSE(circular_buffer_record_init(&ctx, 4, (CIRCULAR_BUFFER_MAX_SIZE / 4) + 1));
+#if CIRCULAR_BUFFER_MAX_SIZE >= 4
+    ASSERT_TRUE(circular_buffer_record_init(&ctx, 4, CIRCULAR_BUFFER_MAX_SIZE / 4));
+#endif
+}
+
+TEST(CircularBufferRecordInitTest, InitWithStorageRoundsDownToWholeRecords)
+{
+    circular_buffer_record_ctx ctx;
+    uint8_t storage[10];
+    size_t capacity = 0;
+
+    ASSERT_FALSE(circular_buffer_record_init_with_storage(&ctx, 4, NULL, sizeof(storage)));
+    ASSERT_FALSE(circular_buffer_record_init_with_storage(&ctx, 11, storage, sizeof(storage)));
+    ASSERT_TRUE(circular_buffer_record_init_with_storage(&ctx, 4, storage, sizeof(storage)));
+    ASSERT_TRUE(circular_buffer_record_get_current_capacity(&ctx, &capacity));
+    EXPECT_EQ(capacity, 2);
+}
+
+TEST(CircularBufferRecordInitTest, EmbeddedStorageRejectsCorruptCountGreaterThanMax)
+{
+#if CIRCULAR_BUFFER_MAX_SIZE >= 4
+    circular_buffer_record_ctx ctx;
+    uint32_t record = 0;
+    ASSERT_TRUE(circular_buffer_record_init(&ctx, sizeof(record), CIRCULAR_BUFFER_MAX_SIZE / sizeof(record)));
+
+    // Would index past the embedded array.
+    ctx.elem_count = CIRCULAR_BUFFER_MAX_SIZE / sizeof(record) + 1;
+    ASSERT_FALSE(circular_buffer_record_push_no_overwrite(&ctx, &record));
+    ASSERT_FALSE(circular_buffer_record_pop(&ctx, &record));
+#else
+    GTEST_SKIP() << "Embedded storage smaller than one record";
+#endif
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferRecordTest, HandlesNullArguments)
+{
+    test_frame frame = make_frame(1);
+    size_t capacity = 0;
+    uint32_t overflow_count = 0;
+    ASSERT_FALSE(circular_buffer_record_push_with_overwrite(NULL, &frame));
+    ASSERT_FALSE(circular_buffer_record_push_with_overwrite(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_record_push_no_overwrite(NULL, &frame));
+    ASSERT_FALSE(circular_buffer_record_push_no_overwrite(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_record_pop(NULL, &frame));
+    ASSERT_FALSE(circular_buffer_record_pop(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_record_peek(NULL, &frame));
+    ASSERT_FALSE(circular_buffer_record_peek(&ctx, NULL));
+    ASSERT_TRUE(circular_buffer_record_is_empty(NULL));
+    ASSERT_FALSE(circular_buffer_record_is_full(NULL));
+    ASSERT_FALSE(circular_buffer_record_get_current_capacity(NULL, &capacity));
+    ASSERT_FALSE(circular_buffer_record_get_overflow_count(NULL, &overflow_count));
+    ASSERT_FALSE(circular_buffer_record_clear_overflow_count(NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferRecordTest, PushPeekPopRecords)
+{
+    test_frame frame_out = {};
+
+    for (uint32_t id = 0; id < elem_count; id++)
+    {
+        test_frame frame_in = make_frame(id);
+        ASSERT_TRUE(circular_buffer_record_push_no_overwrite(&ctx, &frame_in));
+    }
+    ASSERT_TRUE(circular_buffer_record_is_full(&ctx));
+
+    test_frame extra = make_frame(99);
+    ASSERT_FALSE(circular_buffer_record_push_no_overwrite(&ctx, &extra));
+
+    ASSERT_TRUE(circular_buffer_record_peek(&ctx, &frame_out));
+    EXPECT_EQ(frame_out.id, 0);
+
+    for (uint32_t id = 0; id < elem_count; id++)
+    {
+        test_frame expected = make_frame(id);
+        ASSERT_TRUE(circular_buffer_record_pop(&ctx, &frame_out));
+        EXPECT_EQ(memcmp(&frame_out, &expected, sizeof(test_frame)), 0);
+    }
+    ASSERT_TRUE(circular_buffer_record_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_record_pop(&ctx, &frame_out));
+}
+
+TEST_F(CircularBufferRecordTest, OverwriteDropsWholeOldestRecords)
+{
+    uint32_t overflow_count = 0;
+    uint32_t amount_to_overflow = 5;
+    test_frame frame_out = {};
+
+    for (uint32_t id = 0; id < elem_count + amount_to_overflow; id++)
+    {
+        test_frame frame_in = make_frame(id);
+        ASSERT_TRUE(circular_buffer_record_push_with_overwrite(&ctx, &frame_in));
+    }
+
+    // Overflow is counted in records, not bytes.
+    ASSERT_TRUE(circular_buffer_record_get_overflow_count(&ctx, &overflow_count));
+    EXPECT_EQ(overflow_count, amount_to_overflow);
+
+    // The survivors are intact, oldest first.
+    for (uint32_t id = amount_to_overflow; id < elem_count + amount_to_overflow; id++)
+    {
+        test_frame expected = make_frame(id);
+        ASSERT_TRUE(circular_buffer_record_pop(&ctx, &frame_out));
+        EXPECT_EQ(memcmp(&frame_out, &expected, sizeof(test_frame)), 0);
+    }
+    ASSERT_TRUE(circular_buffer_record_is_empty(&ctx));
+
+    ASSERT_TRUE(circular_buffer_record_clear_overflow_count(&ctx));
+    ASSERT_TRUE(circular_buffer_record_get_overflow_count(&ctx, &overflow_count));
+    EXPECT_EQ(overflow_count, 0);
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferRecordTest, ProtectsAgainstCorruptCtx)
+{
+    test_frame frame = make_frame(1);
+    circular_buffer_record_ctx corrupt_ctx = ctx;
+    corrupt_ctx.head = elem_count; // out of bounds index
+    ASSERT_FALSE(circular_buffer_record_push_with_overwrite(&corrupt_ctx, &frame));
+
+    corrupt_ctx = ctx;
+    corrupt_ctx.tail = elem_count; // out of bounds index
+    ASSERT_FALSE(circular_buffer_record_pop(&corrupt_ctx, &frame));
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_sharded.h"
+}
+
+class CircularBufferShardedTest : public ::testing::Test {
+protected:
+    static const size_t shard_count = 4;
+    static const size_t shard_size = 128;
+    circular_buffer_spsc_ctx shards[shard_count];
+    // Spare room for aligning the first shard to a cache line.
+    std::vector<uint8_t> storage = std::vector<uint8_t>(shard_count * shard_size + CIRCULAR_BUFFER_CACHE_LINE_SIZE);
+    circular_buffer_sharded_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_sharded_init_with_storage(&ctx, shards, shard_count, storage.data(),
+                                                              storage.size(), CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferShardedInitTest, InitRejectsInvalidArguments)
+{
+    circular_buffer_sharded_ctx ctx;
+    circular_buffer_spsc_ctx shards[2];
+    uint8_t storage[64];
+
+    ASSERT_FALSE(circular_buffer_sharded_init_with_storage(NULL, shards, 2, storage, sizeof(storage),
+                                                           CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    ASSERT_FALSE(circular_buffer_sharded_init_with_storage(&ctx, NULL, 2, storage, sizeof(storage),
+                                                           CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    ASSERT_FALSE(circular_buffer_sharded_init_with_storage(&ctx, shards, 0, storage, sizeof(storage),
+                                                           CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    ASSERT_FALSE(circular_buffer_sharded_init_with_storage(&ctx, shards, 2, NULL, sizeof(storage),
+                                                           CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    ASSERT_FALSE(circular_buffer_sharded_init_with_storage(&ctx, shards, 2, storage, 1,
+                                                           CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    ASSERT_FALSE(circular_buffer_sharded_init_with_storage(&ctx, shards, 2, storage, sizeof(storage),
+                                                           (circular_buffer_sharded_policy)7));
+}
+
+TEST(CircularBufferShardedInitTest, InitSplitsStorageEvenly)
+{
+    circular_buffer_sharded_ctx ctx;
+    circular_buffer_spsc_ctx shards[3];
+    // The remainder goes unused.
+    std::vector<uint8_t> storage(3 * 256 + 2 + CIRCULAR_BUFFER_CACHE_LINE_SIZE);
+
+    ASSERT_TRUE(circular_buffer_sharded_init_with_storage(&ctx, shards, 3, storage.data(), storage.size(),
+                                                          CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(shards[i].buff_size, 256);
+        EXPECT_EQ(shards[i].buffer, shards[0].buffer + i * 256);
+    }
+    EXPECT_LE(shards[0].buffer - storage.data(), CIRCULAR_BUFFER_CACHE_LINE_SIZE);
+}
+
+TEST(CircularBufferShardedInitTest, InitAlignsShardsToCacheLines)
+{
+#if CIRCULAR_BUFFER_CACHE_LINE_SIZE > 0
+    const size_t line = CIRCULAR_BUFFER_CACHE_LINE_SIZE;
+    circular_buffer_sharded_ctx ctx;
+    circular_buffer_spsc_ctx shards[2];
+    alignas(CIRCULAR_BUFFER_CACHE_LINE_SIZE) uint8_t storage[5 * line];
+
+    // One byte past a line boundary, so the first line - 1 bytes are skipped.
+    ASSERT_TRUE(circular_buffer_sharded_init_with_storage(&ctx, shards, 2, storage + 1, sizeof(storage) - 1,
+                                                          CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    EXPECT_EQ(shards[0].buffer, storage + line);
+    EXPECT_EQ(shards[1].buffer, storage + 3 * line);
+    EXPECT_EQ(shards[1].buff_size, 2 * line);
+
+    // One and a half lines left per shard, rounded down to one.
+    ASSERT_TRUE(circular_buffer_sharded_init_with_storage(&ctx, shards, 2, storage + 1, 4 * line - 1,
+                                                          CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+    EXPECT_EQ(shards[1].buffer, storage + 2 * line);
+    EXPECT_EQ(shards[1].buff_size, line);
+
+    // Less than a whole line per shard.
+    ASSERT_FALSE(circular_buffer_sharded_init_with_storage(&ctx, shards, 2, storage + 1, 3 * line - 2,
+                                                           CIRCULAR_BUFFER_SHARDED_ROUND_ROBIN));
+#else
+    GTEST_SKIP() << "Compact layout, CIRCULAR_BUFFER_CACHE_LINE_SIZE is 0";
+#endif
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferShardedTest, HandlesNullArguments)
+{
+    uint8_t data = 0;
+    size_t read_len = 0;
+    ASSERT_FALSE(circular_buffer_sharded_push(NULL, 0, data));
+    ASSERT_FALSE(circular_buffer_sharded_write(NULL, 0, &data, 1));
+    ASSERT_FALSE(circular_buffer_sharded_write(&ctx, 0, NULL, 1));
+    ASSERT_FALSE(circular_buffer_sharded_read(NULL, &data, 1, &read_len, NULL));
+    ASSERT_FALSE(circular_buffer_sharded_read(&ctx, NULL, 1, &read_len, NULL));
+    ASSERT_FALSE(circular_buffer_sharded_read(&ctx, &data, 1, NULL, NULL));
+    ASSERT_TRUE(circular_buffer_sharded_is_empty(NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferShardedTest, ProducersOnlyFillTheirOwnShard)
+{
+    std::vector<uint8_t> block(shard_size, 1);
+
+    ASSERT_FALSE(circular_buffer_sharded_push(&ctx, shard_count, 0));
+    ASSERT_TRUE(circular_buffer_sharded_write(&ctx, 2, block.data(), shard_size));
+    ASSERT_FALSE(circular_buffer_sharded_push(&ctx, 2, 0));
+    ASSERT_TRUE(circular_buffer_sharded_push(&ctx, 1, 0));
+    ASSERT_TRUE(circular_buffer_spsc_is_full(&shards[2]));
+    ASSERT_TRUE(circular_buffer_spsc_is_empty(&shards[0]));
+}
+
+TEST_F(CircularBufferShardedTest, RoundRobinVisitsShardsInTurn)
+{
+    uint8_t dst[16];
+    size_t read_len = 0;
+    size_t shard = 0;
+
+    ASSERT_TRUE(circular_buffer_sharded_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_sharded_read(&ctx, dst, sizeof(dst), &read_len, &shard));
+
+    // Shard 0 keeps refilling but the others still get their turn.
+    for (size_t i = 0; i < shard_count; i++)
+    {
+        uint8_t block[2] = { (uint8_t)i, (uint8_t)i };
+        ASSERT_TRUE(circular_buffer_sharded_write(&ctx, i, block, sizeof(block)));
+    }
+    ASSERT_FALSE(circular_buffer_sharded_is_empty(&ctx));
+
+    for (size_t i = 0; i < shard_count; i++)
+    {
+        ASSERT_TRUE(circular_buffer_sharded_push(&ctx, 0, 0));
+        ASSERT_TRUE(circular_buffer_sharded_read(&ctx, dst, sizeof(dst), &read_len, &shard));
+        EXPECT_EQ(shard, i);
+        EXPECT_EQ(read_len, (i == 0) ? 3 : 2);
+        EXPECT_EQ(dst[0], i);
+    }
+
+    ASSERT_TRUE(circular_buffer_sharded_read(&ctx, dst, sizeof(dst), &read_len, NULL));
+    EXPECT_EQ(read_len, shard_count - 1);
+    ASSERT_TRUE(circular_buffer_sharded_is_empty(&ctx));
+
+    // The next turn belongs to shard 1, but empty shards are skipped rather than ending the read.
+    ASSERT_TRUE(circular_buffer_sharded_push(&ctx, 0, 0));
+    ASSERT_TRUE(circular_buffer_sharded_read(&ctx, dst, sizeof(dst), &read_len, &shard));
+    EXPECT_EQ(shard, 0);
+}
+
+TEST_F(CircularBufferShardedTest, FullestFirstReadsBusiestShard)
+{
+    uint8_t block[32] = { 0 };
+    uint8_t dst[8];
+    size_t read_len = 0;
+    size_t shard = 0;
+
+    ASSERT_TRUE(circular_buffer_sharded_init_with_storage(&ctx, shards, shard_count, storage.data(),
+                                                          storage.size(), CIRCULAR_BUFFER_SHARDED_FULLEST_FIRST));
+    ASSERT_FALSE(circular_buffer_sharded_read(&ctx, dst, sizeof(dst), &read_len, &shard));
+
+    ASSERT_TRUE(circular_buffer_sharded_write(&ctx, 0, block, 10));
+    ASSERT_TRUE(circular_buffer_sharded_write(&ctx, 3, block, 20));
+    ASSERT_TRUE(circular_buffer_sharded_write(&ctx, 1, block, 14));
+
+    // 8 bytes per read, switching as soon as another shard holds more. Ties go to the lower index.
+    const size_t expected[] = { 3, 1, 3, 0, 1, 3, 0 };
+    for (size_t expected_shard : expected)
+    {
+        ASSERT_TRUE(circular_buffer_sharded_read(&ctx, dst, sizeof(dst), &read_len, &shard));
+        EXPECT_EQ(shard, expected_shard);
+    }
+    ASSERT_TRUE(circular_buffer_sharded_is_empty(&ctx));
+}
+
+/****************** SECTION: Concurrency ************************/
+
+TEST_F(CircularBufferShardedTest, MultiProducerStressTest)
+{
+    const size_t bytes_per_producer = 500000;
+    size_t received[shard_count] = { 0 };
+    size_t mismatches = 0;
+
+    // Every producer's bytes must arrive exactly once and in order.
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < shard_count; p++)
+    {
+        producers.emplace_back([&, p]() {
+            for (size_t i = 0; i < bytes_per_producer; i++)
+            {
+                while (!circular_buffer_sharded_push(&ctx, p, (uint8_t)(i * (p + 1))))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint8_t dst[64];
+    size_t total = 0;
+    while (total < shard_count * bytes_per_producer)
+    {
+        size_t read_len = 0;
+        size_t shard = 0;
+
+        if (!circular_buffer_sharded_read(&ctx, dst, sizeof(dst), &read_len, &shard))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < read_len; i++)
+        {
+            if (dst[i] != (uint8_t)(received[shard] * (shard + 1)))
+            {
+                mismatches++;
+            }
+            received[shard]++;
+        }
+        total += read_len;
+    }
+
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_EQ(mismatches, 0);
+    ASSERT_TRUE(circular_buffer_sharded_is_empty(&ctx));
+}
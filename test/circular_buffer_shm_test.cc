@@ -0,0 +1,263 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_shm.h"
+}
+
+class CircularBufferShmTest : public ::testing::Test {
+protected:
+    size_t buff_size = 256;
+    std::string name = "/circular_buffer_shm_test_" + std::to_string(getpid());
+    circular_buffer_shm_ctx ctx;
+
+    void SetUp() override {
+        (void)shm_unlink(name.c_str());
+        ASSERT_TRUE(circular_buffer_shm_create(&ctx, name.c_str(), buff_size));
+    }
+
+    void TearDown() override {
+        (void)circular_buffer_shm_detach(&ctx);
+        (void)shm_unlink(name.c_str());
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferShmInitTest, HandlesInvalidArguments)
+{
+    circular_buffer_shm_ctx ctx;
+
+    ASSERT_FALSE(circular_buffer_shm_create(NULL, "/circular_buffer_shm_unused", 16));
+    EXPECT_EQ(errno, EINVAL);
+    ASSERT_FALSE(circular_buffer_shm_create(&ctx, NULL, 16));
+    ASSERT_FALSE(circular_buffer_shm_create(&ctx, "/circular_buffer_shm_unused", 0));
+    ASSERT_FALSE(circular_buffer_shm_create(&ctx, "/circular_buffer_shm_unused", (size_t)UINT32_MAX));
+    ASSERT_FALSE(circular_buffer_shm_attach(NULL, "/circular_buffer_shm_unused"));
+    ASSERT_FALSE(circular_buffer_shm_attach(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_shm_detach(NULL));
+}
+
+TEST(CircularBufferShmInitTest, AttachFailsForMissingObject)
+{
+    circular_buffer_shm_ctx ctx;
+
+    ASSERT_FALSE(circular_buffer_shm_attach(&ctx, "/circular_buffer_shm_does_not_exist"));
+    EXPECT_EQ(errno, ENOENT);
+}
+
+TEST_F(CircularBufferShmTest, CreateFailsIfNameExists)
+{
+    circular_buffer_shm_ctx other;
+
+    ASSERT_FALSE(circular_buffer_shm_create(&other, name.c_str(), buff_size));
+    EXPECT_EQ(errno, EEXIST);
+}
+
+TEST_F(CircularBufferShmTest, RegionHoldsNoPointers)
+{
+    // The storage starts right after a header of fixed-width fields, at the same offset in every process.
+    EXPECT_EQ(ctx.region->magic, CIRCULAR_BUFFER_SHM_MAGIC);
+    EXPECT_EQ(ctx.region->version, CIRCULAR_BUFFER_SHM_VERSION);
+    EXPECT_EQ(ctx.region->buff_size, buff_size);
+    EXPECT_EQ(ctx.storage, (uint8_t *)ctx.region + ctx.region->header_size);
+}
+
+/****************** SECTION: Handshake ************************/
+
+TEST_F(CircularBufferShmTest, AttachSeesCreatorData)
+{
+    circular_buffer_shm_ctx attached;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_shm_push(&ctx, 42));
+    ASSERT_TRUE(circular_buffer_shm_attach(&attached, name.c_str()));
+    EXPECT_NE(attached.region, ctx.region);  // A second mapping, at a different address
+    EXPECT_EQ(attached.buff_size, buff_size);
+    ASSERT_TRUE(circular_buffer_shm_pop(&attached, &data_out));
+    EXPECT_EQ(data_out, 42);
+    ASSERT_TRUE(circular_buffer_shm_is_empty(&ctx));
+    ASSERT_TRUE(circular_buffer_shm_detach(&attached));
+}
+
+TEST_F(CircularBufferShmTest, AttachWaitsForReadyState)
+{
+    circular_buffer_shm_ctx attached;
+
+    // As seen by an attacher that runs while the creator is still filling in the header.
+    ctx.region->state = 0;
+    ASSERT_FALSE(circular_buffer_shm_attach(&attached, name.c_str()));
+    EXPECT_EQ(errno, EAGAIN);
+
+    ctx.region->state = CIRCULAR_BUFFER_SHM_READY;
+    ASSERT_TRUE(circular_buffer_shm_attach(&attached, name.c_str()));
+    ASSERT_TRUE(circular_buffer_shm_detach(&attached));
+}
+
+TEST_F(CircularBufferShmTest, AttachRejectsOtherVersionOrLayout)
+{
+    circular_buffer_shm_ctx attached;
+
+    ctx.region->version = CIRCULAR_BUFFER_SHM_VERSION + 1;
+    ASSERT_FALSE(circular_buffer_shm_attach(&attached, name.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+
+    ctx.region->version = CIRCULAR_BUFFER_SHM_VERSION;
+    ctx.region->magic = 0;
+    ASSERT_FALSE(circular_buffer_shm_attach(&attached, name.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+
+    ctx.region->magic = CIRCULAR_BUFFER_SHM_MAGIC;
+    ctx.region->header_size += 64;
+    ASSERT_FALSE(circular_buffer_shm_attach(&attached, name.c_str()));
+    EXPECT_EQ(errno, EINVAL);
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferShmTest, WriteAndReadWrapAround)
+{
+    std::vector<uint8_t> src(100);
+    std::vector<uint8_t> dst(buff_size);
+    size_t read_len = 0;
+
+    ASSERT_FALSE(circular_buffer_shm_read(&ctx, dst.data(), dst.size(), &read_len));
+    ASSERT_FALSE(circular_buffer_shm_write(&ctx, dst.data(), buff_size + 1));
+
+    for (size_t lap = 0; lap < 10; lap++)
+    {
+        for (size_t i = 0; i < src.size(); i++)
+        {
+            src[i] = (uint8_t)(lap + i);
+        }
+        ASSERT_TRUE(circular_buffer_shm_write(&ctx, src.data(), src.size()));
+        ASSERT_TRUE(circular_buffer_shm_read(&ctx, dst.data(), buff_size, &read_len));
+        EXPECT_EQ(read_len, src.size());
+        EXPECT_EQ(memcmp(src.data(), dst.data(), src.size()), 0);
+    }
+
+    // All or nothing when nearly full.
+    ASSERT_TRUE(circular_buffer_shm_write(&ctx, dst.data(), buff_size - 1));
+    ASSERT_FALSE(circular_buffer_shm_write(&ctx, dst.data(), 2));
+    ASSERT_TRUE(circular_buffer_shm_push(&ctx, 0));
+    ASSERT_FALSE(circular_buffer_shm_push(&ctx, 0));
+}
+
+/****************** SECTION: Concurrency ************************/
+
+TEST_F(CircularBufferShmTest, TwoProcessStressTest)
+{
+    const size_t total_bytes = 2000000;
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+
+    if (pid == 0)
+    {
+        // The child attaches by name and produces blocks of varying length.
+        circular_buffer_shm_ctx producer;
+        uint8_t block[61];
+        size_t sent = 0;
+
+        if (!circular_buffer_shm_attach(&producer, name.c_str()))
+        {
+            _exit(1);
+        }
+        while (sent < total_bytes)
+        {
+            size_t len = 1 + (sent % sizeof(block));
+            len = (len < total_bytes - sent) ? len : (total_bytes - sent);
+            for (size_t i = 0; i < len; i++)
+            {
+                block[i] = (uint8_t)((sent + i) * 31);
+            }
+            while (!circular_buffer_shm_write(&producer, block, len))
+            {
+                sched_yield();
+            }
+            sent += len;
+        }
+        _exit(0);
+    }
+
+    // The parent checks that every byte arrives exactly once and in order.
+    uint8_t dst[97];
+    size_t received = 0;
+    size_t mismatches = 0;
+    int status = 0;
+    bool child_exited = false;
+    while (received < total_bytes)
+    {
+        size_t read_len = 0;
+        if (!circular_buffer_shm_read(&ctx, dst, sizeof(dst), &read_len))
+        {
+            // A child that died early must fail the test, not hang it.
+            if (child_exited)
+            {
+                break;
+            }
+            child_exited = (waitpid(pid, &status, WNOHANG) == pid);
+            sched_yield();
+            continue;
+        }
+        for (size_t i = 0; i < read_len; i++, received++)
+        {
+            if (dst[i] != (uint8_t)(received * 31))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    if (!child_exited)
+    {
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    }
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(received, total_bytes);
+    EXPECT_EQ(mismatches, 0);
+    ASSERT_TRUE(circular_buffer_shm_is_empty(&ctx));
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferShmTest, RejectsSizesWhoseIndicesCouldOverflow)
+{
+    circular_buffer_shm_ctx too_big;
+    uint8_t data_out = 0;
+
+    // An index plus a length runs up to 3 * buff_size, which must fit in 32 bits.
+    ASSERT_FALSE(circular_buffer_shm_create(&too_big, "/circular_buffer_shm_unused", (size_t)UINT32_MAX / 4 + 1));
+    EXPECT_EQ(errno, EINVAL);
+
+    ctx.buff_size = UINT32_MAX / 4 + 1;
+    ASSERT_FALSE(circular_buffer_shm_push(&ctx, 0));
+    ASSERT_FALSE(circular_buffer_shm_pop(&ctx, &data_out));
+
+    ctx.buff_size = buff_size;
+    ASSERT_TRUE(circular_buffer_shm_push(&ctx, 0));
+}
+
+TEST_F(CircularBufferShmTest, ProtectsAgainstCorruptRegion)
+{
+    uint8_t data_out = 0;
+
+    // Another process scribbles over the shared indices or the shared size.
+    ctx.region->head = 2 * buff_size;
+    ASSERT_FALSE(circular_buffer_shm_push(&ctx, 0));
+    ASSERT_FALSE(circular_buffer_shm_pop(&ctx, &data_out));
+
+    ctx.region->head = 0;
+    ctx.region->buff_size = UINT32_MAX;
+    ASSERT_TRUE(circular_buffer_shm_push(&ctx, 0));
+    ASSERT_TRUE(circular_buffer_shm_pop(&ctx, &data_out));
+}
@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_spsc.h"
+}
+
+class CircularBufferSpscTest : public ::testing::Test {
+protected:
+    size_t buff_size = 256;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(buff_size);  // Caller storage works in every build
+    circular_buffer_spsc_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_spsc_init_with_storage(&ctx, storage.data(), storage.size()));
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferSpscInitTest, InitHandlesNULLCtx)
+{
+    ASSERT_FALSE(circular_buffer_spsc_init(NULL, 256));
+}
+
+TEST(CircularBufferSpscInitTest, InitDoesNotAllowBuffSizeOfZero)
+{
+    circular_buffer_spsc_ctx ctx;
+    ASSERT_FALSE(circular_buffer_spsc_init(&ctx, 0));
+}
+
+TEST(CircularBufferSpscInitTest, InitDoesNotAllowBuffSizeGreaterThanMax)
+{
+    circular_buffer_spsc_ctx ctx;
+    ASSERT_FALSE(circular_buffer_spsc_init(&ctx, CIRCULAR_BUFFER_MAX_SIZE + 1));
+}
+
+TEST(CircularBufferSpscInitTest, InitWithStorageUsesCallerMemory)
+{
+    circular_buffer_spsc_ctx ctx;
+    uint8_t storage[3] = { 0 };
+    uint8_t data_out = 0;
+
+    ASSERT_FALSE(circular_buffer_spsc_init_with_storage(NULL, storage, sizeof(storage)));
+    ASSERT_FALSE(circular_buffer_spsc_init_with_storage(&ctx, NULL, sizeof(storage)));
+    ASSERT_FALSE(circular_buffer_spsc_init_with_storage(&ctx, storage, 0));
+    ASSERT_TRUE(circular_buffer_spsc_init_with_storage(&ctx, storage, sizeof(storage)));
+
+    for (size_t i = 0; i < sizeof(storage); i++)
+    {
+        ASSERT_TRUE(circular_buffer_spsc_push(&ctx, (uint8_t)(i + 1)));
+        EXPECT_EQ(storage[i], (uint8_t)(i + 1));
+    }
+    ASSERT_TRUE(circular_buffer_spsc_is_full(&ctx));
+    ASSERT_TRUE(circular_buffer_spsc_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 1);
+}
+
+TEST(CircularBufferSpscInitTest, EmbeddedStorageRejectsCorruptSizeGreaterThanMax)
+{
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    circular_buffer_spsc_ctx ctx;
+    uint8_t data_out = 0;
+    ASSERT_TRUE(circular_buffer_spsc_init(&ctx, CIRCULAR_BUFFER_MAX_SIZE));
+
+    // Would index past the embedded array.
+    ctx.buff_size = CIRCULAR_BUFFER_MAX_SIZE + 1;
+    ASSERT_FALSE(circular_buffer_spsc_push(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_spsc_write(&ctx, (const uint8_t *)"ab", 2));
+    ASSERT_FALSE(circular_buffer_spsc_pop(&ctx, &data_out));
+#else
+    GTEST_SKIP() << "No embedded storage, CIRCULAR_BUFFER_MAX_SIZE is 0";
+#endif
+}
+
+TEST(CircularBufferSpscInitTest, CacheLineLayoutSeparatesProducerAndConsumer)
+{
+#if CIRCULAR_BUFFER_CACHE_LINE_SIZE > 0
+    size_t line = CIRCULAR_BUFFER_CACHE_LINE_SIZE;
+    size_t head_line = offsetof(circular_buffer_spsc_ctx, head) / line;
+    size_t tail_line = offsetof(circular_buffer_spsc_ctx, tail) / line;
+
+    EXPECT_EQ(alignof(circular_buffer_spsc_ctx) % line, 0);
+    EXPECT_NE(head_line, tail_line);
+    EXPECT_NE(head_line, offsetof(circular_buffer_spsc_ctx, buffer) / line);
+    // Each side's cached copy sits with the index that side writes.
+    EXPECT_EQ(offsetof(circular_buffer_spsc_ctx, cached_tail) / line, head_line);
+    EXPECT_EQ(offsetof(circular_buffer_spsc_ctx, cached_head) / line, tail_line);
+#else
+    GTEST_SKIP() << "Compact layout, CIRCULAR_BUFFER_CACHE_LINE_SIZE is 0";
+#endif
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferSpscTest, HandlesNullArguments)
+{
+    uint8_t data = 0;
+    size_t capacity = 0;
+    ASSERT_FALSE(circular_buffer_spsc_push(NULL, data));
+    ASSERT_FALSE(circular_buffer_spsc_pop(NULL, &data));
+    ASSERT_FALSE(circular_buffer_spsc_pop(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_spsc_peek(NULL, &data));
+    ASSERT_FALSE(circular_buffer_spsc_peek(&ctx, NULL));
+    ASSERT_TRUE(circular_buffer_spsc_is_empty(NULL));
+    ASSERT_FALSE(circular_buffer_spsc_is_full(NULL));
+    ASSERT_FALSE(circular_buffer_spsc_get_current_capacity(NULL, &capacity));
+    ASSERT_FALSE(circular_buffer_spsc_get_current_capacity(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_spsc_write(NULL, &data, 1));
+    ASSERT_FALSE(circular_buffer_spsc_write(&ctx, NULL, 1));
+    ASSERT_FALSE(circular_buffer_spsc_read(NULL, &data, 1, &capacity));
+    ASSERT_FALSE(circular_buffer_spsc_read(&ctx, NULL, 1, &capacity));
+    ASSERT_FALSE(circular_buffer_spsc_read(&ctx, &data, 1, NULL));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferSpscTest, PushPeekPopData)
+{
+    uint8_t data_out = 0;
+    ASSERT_TRUE(circular_buffer_spsc_push(&ctx, 42));
+    ASSERT_FALSE(circular_buffer_spsc_is_empty(&ctx));
+    ASSERT_TRUE(circular_buffer_spsc_peek(&ctx, &data_out));
+    EXPECT_EQ(data_out, 42);
+    data_out = 0;
+    ASSERT_TRUE(circular_buffer_spsc_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 42);
+    ASSERT_TRUE(circular_buffer_spsc_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_spsc_pop(&ctx, &data_out));
+}
+
+TEST_F(CircularBufferSpscTest, PushFailsForFullBufferWithoutOverwriting)
+{
+    size_t capacity = 0;
+    uint8_t data_out = 0;
+
+    // Run several laps so both indices cross the wrap point and the 2 * buff_size rollover.
+    for (size_t lap = 0; lap < 5; lap++)
+    {
+        for (size_t i = 0; i < buff_size; i++)
+        {
+            ASSERT_TRUE(circular_buffer_spsc_push(&ctx, (uint8_t)(i + lap)));
+        }
+        ASSERT_TRUE(circular_buffer_spsc_is_full(&ctx));
+        ASSERT_FALSE(circular_buffer_spsc_push(&ctx, 0xFF));
+        ASSERT_TRUE(circular_buffer_spsc_get_current_capacity(&ctx, &capacity));
+        EXPECT_EQ(capacity, 0);
+
+        for (size_t i = 0; i < buff_size; i++)
+        {
+            ASSERT_TRUE(circular_buffer_spsc_pop(&ctx, &data_out));
+            EXPECT_EQ(data_out, (uint8_t)(i + lap));
+        }
+        ASSERT_TRUE(circular_buffer_spsc_is_empty(&ctx));
+        ASSERT_TRUE(circular_buffer_spsc_get_current_capacity(&ctx, &capacity));
+        EXPECT_EQ(capacity, buff_size);
+    }
+}
+
+/****************** SECTION: Bulk Operations ************************/
+
+TEST_F(CircularBufferSpscTest, WriteIsAllOrNothing)
+{
+    std::vector<uint8_t> block(buff_size + 1, 7);
+    size_t capacity = 0;
+
+    ASSERT_FALSE(circular_buffer_spsc_write(&ctx, block.data(), buff_size + 1));
+    ASSERT_TRUE(circular_buffer_spsc_write(&ctx, block.data(), buff_size - 10));
+    ASSERT_FALSE(circular_buffer_spsc_write(&ctx, block.data(), 11));
+    ASSERT_TRUE(circular_buffer_spsc_get_current_capacity(&ctx, &capacity));
+    EXPECT_EQ(capacity, 10);
+    ASSERT_TRUE(circular_buffer_spsc_write(&ctx, block.data(), 10));
+    ASSERT_TRUE(circular_buffer_spsc_is_full(&ctx));
+}
+
+TEST_F(CircularBufferSpscTest, ReadReturnsWhatIsStoredUpToLen)
+{
+    std::vector<uint8_t> src(buff_size);
+    std::vector<uint8_t> dst(buff_size);
+    size_t read_len = 99;
+
+    ASSERT_FALSE(circular_buffer_spsc_read(&ctx, dst.data(), dst.size(), &read_len));
+    EXPECT_EQ(read_len, 0);
+
+    // Blocks of 100 bytes over several laps, so copies split at the end of storage and
+    // the indices cross the 2 * buff_size rollover.
+    for (size_t lap = 0; lap < 10; lap++)
+    {
+        for (size_t i = 0; i < 100; i++)
+        {
+            src[i] = (uint8_t)(lap * 100 + i);
+        }
+        ASSERT_TRUE(circular_buffer_spsc_write(&ctx, src.data(), 100));
+
+        ASSERT_TRUE(circular_buffer_spsc_read(&ctx, dst.data(), 60, &read_len));
+        EXPECT_EQ(read_len, 60);
+        ASSERT_TRUE(circular_buffer_spsc_read(&ctx, dst.data() + 60, buff_size, &read_len));
+        EXPECT_EQ(read_len, 40);
+        EXPECT_EQ(memcmp(src.data(), dst.data(), 100), 0);
+        ASSERT_TRUE(circular_buffer_spsc_is_empty(&ctx));
+    }
+}
+
+TEST_F(CircularBufferSpscTest, BulkAndSingleByteCallsInterleave)
+{
+    uint8_t block[3] = { 1, 2, 3 };
+    uint8_t data_out = 0;
+    size_t read_len = 0;
+
+    ASSERT_TRUE(circular_buffer_spsc_push(&ctx, 0));
+    ASSERT_TRUE(circular_buffer_spsc_write(&ctx, block, sizeof(block)));
+    ASSERT_TRUE(circular_buffer_spsc_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 0);
+    ASSERT_TRUE(circular_buffer_spsc_read(&ctx, block, 2, &read_len));
+    EXPECT_EQ(block[0], 1);
+    EXPECT_EQ(block[1], 2);
+    ASSERT_TRUE(circular_buffer_spsc_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 3);
+}
+
+/****************** SECTION: Concurrency ************************/
+
+TEST_F(CircularBufferSpscTest, MultiThreadedStressTest)
+{
+    const size_t total_bytes = 2000000;
+    size_t mismatches = 0;
+
+    // The consumer checks that every byte arrives exactly once and in order.
+    std::thread consumer([&]() {
+        for (size_t i = 0; i < total_bytes; i++)
+        {
+            uint8_t data_out = 0;
+            while (!circular_buffer_spsc_pop(&ctx, &data_out))
+            {
+                std::this_thread::yield();
+            }
+            if (data_out != (uint8_t)(i * 31))
+            {
+                mismatches++;
+            }
+        }
+    });
+
+    for (size_t i = 0; i < total_bytes; i++)
+    {
+        while (!circular_buffer_spsc_push(&ctx, (uint8_t)(i * 31)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    consumer.join();
+    EXPECT_EQ(mismatches, 0);
+    ASSERT_TRUE(circular_buffer_spsc_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferSpscTest, MultiThreadedBulkStressTest)
+{
+    const size_t total_blocks = 200000;
+    const size_t block_len = 7;
+    size_t mismatches = 0;
+
+    // Blocks are written whole, so the consumer must always see whole blocks in order.
+    std::thread consumer([&]() {
+        uint8_t dst[block_len * 4];
+        size_t received = 0;
+        size_t read_len = 0;
+
+        while (received < total_blocks * block_len)
+        {
+            if (!circular_buffer_spsc_read(&ctx, dst, sizeof(dst), &read_len))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < read_len; i++, received++)
+            {
+                if (dst[i] != (uint8_t)((received / block_len) * 31 + (received % block_len)))
+                {
+                    mismatches++;
+                }
+            }
+        }
+    });
+
+    for (size_t b = 0; b < total_blocks; b++)
+    {
+        uint8_t block[block_len];
+        for (size_t i = 0; i < block_len; i++)
+        {
+            block[i] = (uint8_t)(b * 31 + i);
+        }
+        while (!circular_buffer_spsc_write(&ctx, block, block_len))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    consumer.join();
+    EXPECT_EQ(mismatches, 0);
+    ASSERT_TRUE(circular_buffer_spsc_is_empty(&ctx));
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferSpscTest, ProtectsAgainstCorruptCtx)
+{
+    uint8_t data_out = 0;
+    circular_buffer_spsc_ctx corrupt_ctx = ctx;
+    corrupt_ctx.head = 2 * buff_size; // out of bounds index
+    ASSERT_FALSE(circular_buffer_spsc_push(&corrupt_ctx, 0));
+    ASSERT_FALSE(circular_buffer_spsc_pop(&corrupt_ctx, &data_out));
+    ASSERT_FALSE(circular_buffer_spsc_peek(&corrupt_ctx, &data_out));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <stdbool.h>
 #include <time.h>
+#include <vector>
 
 extern "C" {
 #include "circular_buffer.h"
@@ -17,10 +18,11 @@ private:
     int best_seed_ever = 42;
 protected:
     size_t buff_size = 256;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(buff_size);  // Caller storage works in every build
     circular_buffer_ctx ctx;
 
     void SetUp() override {
-        ASSERT_TRUE(circular_buffer_init(&ctx, buff_size));
+        ASSERT_TRUE(circular_buffer_init_with_storage(&ctx, storage.data(), storage.size()));
 
         // Set up the seed only once per full testing run.
         if (!seed_is_set) {
@@ -56,16 +58,95 @@ TEST(CircularBufferInitTest, InitDoesNotAllowBuffSizeGreaterThanMax)
 
 TEST(CircularBufferInitTest, InitDoesAllowBuffSizeLessThanMax)
 {
+#if CIRCULAR_BUFFER_MAX_SIZE > 1
     circular_buffer_ctx ctx;
     size_t buff_size = CIRCULAR_BUFFER_MAX_SIZE - 1; // size less than the max
     ASSERT_TRUE(circular_buffer_init(&ctx, buff_size));
+#else
+    GTEST_SKIP() << "No embedded storage below CIRCULAR_BUFFER_MAX_SIZE";
+#endif
 }
 
 TEST(CircularBufferInitTest, InitDoesAllowBuffSizeEqualToMax)
 {
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
     circular_buffer_ctx ctx;
     size_t buff_size = CIRCULAR_BUFFER_MAX_SIZE; // size equal to the max
     ASSERT_TRUE(circular_buffer_init(&ctx, buff_size));
+#else
+    GTEST_SKIP() << "No embedded storage, CIRCULAR_BUFFER_MAX_SIZE is 0";
+#endif
+}
+
+TEST(CircularBufferInitTest, InitWithStorageHandlesNullArguments)
+{
+    circular_buffer_ctx ctx;
+    uint8_t storage[16];
+    ASSERT_FALSE(circular_buffer_init_with_storage(NULL, storage, sizeof(storage)));
+    ASSERT_FALSE(circular_buffer_init_with_storage(&ctx, NULL, sizeof(storage)));
+}
+
+TEST(CircularBufferInitTest, InitWithStorageDoesNotAllowLenOfZero)
+{
+    circular_buffer_ctx ctx;
+    uint8_t storage[16];
+    ASSERT_FALSE(circular_buffer_init_with_storage(&ctx, storage, 0));
+}
+
+TEST(CircularBufferInitTest, InitWithStorageUsesCallerMemory)
+{
+    circular_buffer_ctx ctx;
+    uint8_t storage[4] = { 0 };
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_init_with_storage(&ctx, storage, sizeof(storage)));
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0xAB));
+    EXPECT_EQ(storage[0], 0xAB); // Landed in the caller's memory.
+
+    // The buffer is exactly as big as the storage handed in.
+    for (size_t i = 1; i < sizeof(storage); i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_TRUE(circular_buffer_is_full(&ctx));
+    ASSERT_FALSE(circular_buffer_push_no_overwrite(&ctx, 0));
+
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 0xAB);
+}
+
+TEST(CircularBufferInitTest, InitWithStorageAllowsSizeGreaterThanMax)
+{
+    circular_buffer_ctx ctx;
+    size_t buff_size = (CIRCULAR_BUFFER_MAX_SIZE + 1) * 64;
+    std::vector<uint8_t> storage(buff_size);
+    std::vector<uint8_t> data_in(buff_size), data_out(buff_size);
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        data_in[i] = random_uint8();
+    }
+
+    ASSERT_TRUE(circular_buffer_init_with_storage(&ctx, storage.data(), buff_size));
+    ASSERT_TRUE(circular_buffer_write(&ctx, data_in.data(), buff_size, false));
+    ASSERT_TRUE(circular_buffer_is_full(&ctx));
+    ASSERT_TRUE(circular_buffer_read(&ctx, data_out.data(), buff_size));
+    EXPECT_EQ(data_in, data_out);
+}
+
+TEST(CircularBufferInitTest, EmbeddedStorageRejectsCorruptSizeGreaterThanMax)
+{
+#if CIRCULAR_BUFFER_MAX_SIZE > 0
+    circular_buffer_ctx ctx;
+    ASSERT_TRUE(circular_buffer_init(&ctx, CIRCULAR_BUFFER_MAX_SIZE));
+
+    // Would index past the embedded array.
+    ctx.buff_size = CIRCULAR_BUFFER_MAX_SIZE + 1;
+    ASSERT_FALSE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_write(&ctx, (const uint8_t *)"ab", 2, false));
+#else
+    GTEST_SKIP() << "No embedded storage, CIRCULAR_BUFFER_MAX_SIZE is 0";
+#endif
 }
 
 /****************** SECTION: NULL Inputs ************************/
@@ -137,6 +218,53 @@ TEST_F(CircularBufferTest, GetOverflowCountHandlesNullOverflowCount)
     ASSERT_FALSE(circular_buffer_get_overflow_count(&ctx, NULL));
 }
 
+TEST_F(CircularBufferTest, WriteHandlesNullCtx)
+{
+    uint8_t data_in[4] = { 0 };
+    ASSERT_FALSE(circular_buffer_write(NULL, data_in, sizeof(data_in), true));
+}
+
+TEST_F(CircularBufferTest, WriteHandlesNullSrc)
+{
+    ASSERT_FALSE(circular_buffer_write(&ctx, NULL, 4, true));
+}
+
+TEST_F(CircularBufferTest, ReadHandlesNullCtx)
+{
+    uint8_t data_out[4] = { 0 };
+    ASSERT_FALSE(circular_buffer_read(NULL, data_out, sizeof(data_out)));
+}
+
+TEST_F(CircularBufferTest, ReadHandlesNullDst)
+{
+    ASSERT_FALSE(circular_buffer_read(&ctx, NULL, 0));
+}
+
+TEST_F(CircularBufferTest, ReserveHandlesNullArguments)
+{
+    uint8_t *ptr = NULL;
+    size_t len = 0;
+    ASSERT_FALSE(circular_buffer_reserve(NULL, &ptr, &len));
+    ASSERT_FALSE(circular_buffer_reserve(&ctx, NULL, &len));
+    ASSERT_FALSE(circular_buffer_reserve(&ctx, &ptr, NULL));
+}
+
+TEST_F(CircularBufferTest, PeekContiguousHandlesNullArguments)
+{
+    const uint8_t *ptr = NULL;
+    size_t len = 0;
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_peek_contiguous(NULL, &ptr, &len));
+    ASSERT_FALSE(circular_buffer_peek_contiguous(&ctx, NULL, &len));
+    ASSERT_FALSE(circular_buffer_peek_contiguous(&ctx, &ptr, NULL));
+}
+
+TEST_F(CircularBufferTest, CommitAndConsumeHandleNullCtx)
+{
+    ASSERT_FALSE(circular_buffer_commit(NULL, 1));
+    ASSERT_FALSE(circular_buffer_consume(NULL, 1));
+}
+
 /****************** SECTION: Basic Usage ************************/
 
 TEST_F(CircularBufferTest, PushData)
@@ -562,6 +690,886 @@ TEST_F(CircularBufferTest, IsEmptyConsistency)
     ASSERT_TRUE(circular_buffer_is_empty(&ctx));
 }
 
+/****************** SECTION: Bulk Transfers ************************/
+
+TEST_F(CircularBufferTest, WriteReadData)
+{
+    uint8_t data_in[buff_size] = { 0 };
+    uint8_t data_out[buff_size] = { 0 };
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        data_in[i] = random_uint8();
+    }
+
+    ASSERT_TRUE(circular_buffer_write(&ctx, data_in, buff_size, false));
+    ASSERT_TRUE(circular_buffer_is_full(&ctx));
+    ASSERT_TRUE(circular_buffer_read(&ctx, data_out, buff_size));
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        EXPECT_EQ(data_in[i], data_out[i]);
+    }
+}
+
+TEST_F(CircularBufferTest, WriteNoOverwriteMatchesBytewiseApi)
+{
+    circular_buffer_ctx bytewise_ctx;
+    std::vector<uint8_t> bytewise_storage(buff_size);
+    ASSERT_TRUE(circular_buffer_init_with_storage(&bytewise_ctx, bytewise_storage.data(), buff_size));
+
+    // Odd sized chunks walk head and tail across the wrap point many times.
+    for (size_t round = 0; round < 64; round++)
+    {
+        uint8_t chunk[buff_size] = { 0 };
+        size_t chunk_len = (size_t)(rand() % (buff_size / 2)) + 1;
+        size_t capacity = 0;
+
+        for (size_t i = 0; i < chunk_len; i++)
+        {
+            chunk[i] = random_uint8();
+        }
+
+        ASSERT_TRUE(circular_buffer_get_current_capacity(&ctx, &capacity));
+        if (chunk_len <= capacity)
+        {
+            ASSERT_TRUE(circular_buffer_write(&ctx, chunk, chunk_len, false));
+            for (size_t i = 0; i < chunk_len; i++)
+            {
+                ASSERT_TRUE(circular_buffer_push_no_overwrite(&bytewise_ctx, chunk[i]));
+            }
+        }
+        else
+        {
+            ASSERT_FALSE(circular_buffer_write(&ctx, chunk, chunk_len, false));
+        }
+
+        // Drain a random amount through both APIs and compare.
+        ASSERT_TRUE(circular_buffer_get_current_capacity(&ctx, &capacity));
+        size_t stored = buff_size - capacity;
+        size_t drain_len = stored ? (size_t)(rand() % stored) + 1 : 0;
+        uint8_t bulk_out[buff_size] = { 0 };
+
+        ASSERT_TRUE(circular_buffer_read(&ctx, bulk_out, drain_len));
+        for (size_t i = 0; i < drain_len; i++)
+        {
+            uint8_t bytewise_out = 0;
+            ASSERT_TRUE(circular_buffer_pop(&bytewise_ctx, &bytewise_out));
+            EXPECT_EQ(bulk_out[i], bytewise_out);
+        }
+    }
+}
+
+TEST_F(CircularBufferTest, WriteOverwriteMatchesBytewiseApi)
+{
+    circular_buffer_ctx bytewise_ctx;
+    std::vector<uint8_t> bytewise_storage(buff_size);
+    uint32_t overflow_count = 0, bytewise_overflow_count = 0;
+    ASSERT_TRUE(circular_buffer_init_with_storage(&bytewise_ctx, bytewise_storage.data(), buff_size));
+
+    // Chunks of up to twice buff_size overflow both partially and completely.
+    for (size_t round = 0; round < 64; round++)
+    {
+        uint8_t chunk[buff_size * 2] = { 0 };
+        size_t chunk_len = (size_t)(rand() % (buff_size * 2)) + 1;
+
+        for (size_t i = 0; i < chunk_len; i++)
+        {
+            chunk[i] = random_uint8();
+            ASSERT_TRUE(circular_buffer_push_with_overwrite(&bytewise_ctx, chunk[i]));
+        }
+        ASSERT_TRUE(circular_buffer_write(&ctx, chunk, chunk_len, true));
+
+        // Pop a few bytes so the next write starts at a new offset.
+        for (size_t i = 0; i < (size_t)(rand() % 8); i++)
+        {
+            uint8_t bulk_out = 0, bytewise_out = 0;
+            ASSERT_TRUE(circular_buffer_read(&ctx, &bulk_out, 1));
+            ASSERT_TRUE(circular_buffer_pop(&bytewise_ctx, &bytewise_out));
+            EXPECT_EQ(bulk_out, bytewise_out);
+        }
+    }
+
+    ASSERT_TRUE(circular_buffer_get_overflow_count(&ctx, &overflow_count));
+    ASSERT_TRUE(circular_buffer_get_overflow_count(&bytewise_ctx, &bytewise_overflow_count));
+    EXPECT_EQ(overflow_count, bytewise_overflow_count);
+
+    // Whatever is left must match byte for byte.
+    uint8_t bytewise_out = 0;
+    while (circular_buffer_pop(&bytewise_ctx, &bytewise_out))
+    {
+        uint8_t bulk_out = 0;
+        ASSERT_TRUE(circular_buffer_read(&ctx, &bulk_out, 1));
+        EXPECT_EQ(bulk_out, bytewise_out);
+    }
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+/****************** SECTION: Lookahead ************************/
+
+TEST_F(CircularBufferTest, PeekAtAndPeekRangeHandleNullArguments)
+{
+    uint8_t data = 0;
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_peek_at(NULL, 0, &data));
+    ASSERT_FALSE(circular_buffer_peek_at(&ctx, 0, NULL));
+    ASSERT_FALSE(circular_buffer_peek_range(NULL, 0, &data, 1));
+    ASSERT_FALSE(circular_buffer_peek_range(&ctx, 0, NULL, 1));
+}
+
+TEST_F(CircularBufferTest, PeekAtReadsAnyStoredByteAcrossWrapPoint)
+{
+    uint8_t data_out = 0;
+
+    // Start near the end of storage so the stored bytes wrap.
+    ASSERT_TRUE(circular_buffer_commit(&ctx, buff_size - 3));
+    ASSERT_TRUE(circular_buffer_consume(&ctx, buff_size - 3));
+    for (size_t i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, (uint8_t)(i + 10)));
+    }
+
+    for (size_t i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(circular_buffer_peek_at(&ctx, i, &data_out));
+        EXPECT_EQ(data_out, (uint8_t)(i + 10));
+    }
+    ASSERT_FALSE(circular_buffer_peek_at(&ctx, 8, &data_out));
+
+    // Nothing was consumed.
+    ASSERT_TRUE(circular_buffer_peek(&ctx, &data_out));
+    EXPECT_EQ(data_out, 10);
+    EXPECT_EQ(ctx.current_byte_count, 8);
+}
+
+TEST_F(CircularBufferTest, PeekRangeCopiesWithoutConsuming)
+{
+    std::vector<uint8_t> in(20), out(4, 0);
+
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        in[i] = (uint8_t)i;
+    }
+    ASSERT_TRUE(circular_buffer_commit(&ctx, buff_size - 4));
+    ASSERT_TRUE(circular_buffer_consume(&ctx, buff_size - 4));
+    ASSERT_TRUE(circular_buffer_write(&ctx, in.data(), in.size(), false));
+
+    // Bytes 2 to 5 straddle the end of storage.
+    ASSERT_TRUE(circular_buffer_peek_range(&ctx, 2, out.data(), out.size()));
+    EXPECT_EQ(out, (std::vector<uint8_t>{ 2, 3, 4, 5 }));
+
+    ASSERT_TRUE(circular_buffer_peek_range(&ctx, 16, out.data(), 4));
+    EXPECT_EQ(out, (std::vector<uint8_t>{ 16, 17, 18, 19 }));
+    ASSERT_TRUE(circular_buffer_peek_range(&ctx, 20, out.data(), 0));
+    ASSERT_FALSE(circular_buffer_peek_range(&ctx, 17, out.data(), 4));
+    ASSERT_FALSE(circular_buffer_peek_range(&ctx, SIZE_MAX, out.data(), 2));
+    EXPECT_EQ(ctx.current_byte_count, in.size());
+}
+
+/****************** SECTION: Skip and Clear ************************/
+
+TEST_F(CircularBufferTest, SkipAndClearHandleNullCtx)
+{
+    ASSERT_FALSE(circular_buffer_skip(NULL, 0));
+    ASSERT_FALSE(circular_buffer_clear(NULL));
+}
+
+TEST_F(CircularBufferTest, SkipDropsOldestBytesAcrossWrapPoint)
+{
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_commit(&ctx, buff_size - 5));
+    ASSERT_TRUE(circular_buffer_consume(&ctx, buff_size - 5));
+    for (size_t i = 0; i < 20; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+
+    ASSERT_TRUE(circular_buffer_skip(&ctx, 0));
+    ASSERT_TRUE(circular_buffer_skip(&ctx, 12));
+    EXPECT_EQ(ctx.current_byte_count, 8);
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 12);
+
+    // All or nothing: asking for more than is stored drops nothing.
+    ASSERT_FALSE(circular_buffer_skip(&ctx, 8));
+    EXPECT_EQ(ctx.current_byte_count, 7);
+    ASSERT_TRUE(circular_buffer_skip(&ctx, 7));
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferTest, ClearEmptiesButKeepsOverflowCount)
+{
+    uint32_t overflow_count = 0;
+    uint8_t data_out = 0;
+
+    for (size_t i = 0; i < buff_size + 3; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_with_overwrite(&ctx, (uint8_t)i));
+    }
+
+    ASSERT_TRUE(circular_buffer_clear(&ctx));
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_pop(&ctx, &data_out));
+    ASSERT_TRUE(circular_buffer_get_overflow_count(&ctx, &overflow_count));
+    EXPECT_EQ(overflow_count, 3);
+
+    // Usable straight away, with the whole buffer available again.
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 0);
+}
+
+/****************** SECTION: Zero-Copy Regions ************************/
+
+TEST_F(CircularBufferTest, ReserveCommitThenPop)
+{
+    uint8_t *region = NULL;
+    size_t region_len = 0;
+    uint8_t data_in[16] = { 0 };
+
+    ASSERT_TRUE(circular_buffer_reserve(&ctx, &region, &region_len));
+    ASSERT_EQ(region_len, buff_size); // Fresh buffer offers all of it.
+
+    // Fill part of the region in place, as a DMA engine would.
+    for (size_t i = 0; i < sizeof(data_in); i++)
+    {
+        data_in[i] = random_uint8();
+        region[i] = data_in[i];
+    }
+    ASSERT_TRUE(circular_buffer_commit(&ctx, sizeof(data_in)));
+
+    for (size_t i = 0; i < sizeof(data_in); i++)
+    {
+        uint8_t data_out = 0;
+        ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+        EXPECT_EQ(data_in[i], data_out);
+    }
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferTest, ReserveStopsAtTailAndWrapPoint)
+{
+    uint8_t *region = NULL;
+    size_t region_len = 0;
+    size_t quarter = buff_size / 4;
+
+    // Leave data in the middle of the buffer: tail at quarter, head at 3 * quarter.
+    for (size_t i = 0; i < 3 * quarter; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, random_uint8()));
+    }
+    ASSERT_TRUE(circular_buffer_consume(&ctx, quarter));
+
+    // Free space after head runs to the end of storage.
+    ASSERT_TRUE(circular_buffer_reserve(&ctx, &region, &region_len));
+    EXPECT_EQ(region_len, buff_size - (3 * quarter));
+    ASSERT_TRUE(circular_buffer_commit(&ctx, region_len));
+
+    // Head has wrapped, so the next region ends at tail.
+    ASSERT_TRUE(circular_buffer_reserve(&ctx, &region, &region_len));
+    EXPECT_EQ(region_len, quarter);
+    ASSERT_TRUE(circular_buffer_commit(&ctx, region_len));
+
+    ASSERT_TRUE(circular_buffer_is_full(&ctx));
+    ASSERT_FALSE(circular_buffer_reserve(&ctx, &region, &region_len));
+}
+
+TEST_F(CircularBufferTest, CommitRejectsMoreThanReservedRegion)
+{
+    uint8_t *region = NULL;
+    size_t region_len = 0;
+    size_t quarter = buff_size / 4;
+
+    // Tail at quarter, head at 3 * quarter: free space is split across the wrap point.
+    for (size_t i = 0; i < 3 * quarter; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, random_uint8()));
+    }
+    ASSERT_TRUE(circular_buffer_consume(&ctx, quarter));
+
+    size_t free_space = 0;
+    ASSERT_TRUE(circular_buffer_reserve(&ctx, &region, &region_len));
+    ASSERT_TRUE(circular_buffer_get_current_capacity(&ctx, &free_space));
+    ASSERT_LT(region_len, free_space);
+
+    // The rest of the free space was never handed out, so it can not be published.
+    ASSERT_FALSE(circular_buffer_commit(&ctx, region_len + 1));
+    ASSERT_TRUE(circular_buffer_get_current_capacity(&ctx, &free_space));
+    ASSERT_EQ(free_space, 2 * quarter);
+
+    ASSERT_TRUE(circular_buffer_commit(&ctx, region_len));
+    ASSERT_TRUE(circular_buffer_get_current_capacity(&ctx, &free_space));
+    ASSERT_EQ(free_space, 2 * quarter - region_len);
+}
+
+TEST_F(CircularBufferTest, PeekContiguousConsumeAcrossWrapPoint)
+{
+    uint8_t data_in[buff_size] = { 0 };
+    const uint8_t *region = NULL;
+    size_t region_len = 0;
+    size_t offset = buff_size - 10;
+
+    // Move tail near the end so the stored data wraps.
+    for (size_t i = 0; i < offset; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    }
+    ASSERT_TRUE(circular_buffer_consume(&ctx, offset));
+
+    for (size_t i = 0; i < 32; i++)
+    {
+        data_in[i] = random_uint8();
+    }
+    ASSERT_TRUE(circular_buffer_write(&ctx, data_in, 32, false));
+
+    // First span ends at the wrap point.
+    ASSERT_TRUE(circular_buffer_peek_contiguous(&ctx, &region, &region_len));
+    ASSERT_EQ(region_len, 10);
+    for (size_t i = 0; i < region_len; i++)
+    {
+        EXPECT_EQ(region[i], data_in[i]);
+    }
+    ASSERT_TRUE(circular_buffer_consume(&ctx, region_len));
+
+    // Second span picks up at the start of storage.
+    ASSERT_TRUE(circular_buffer_peek_contiguous(&ctx, &region, &region_len));
+    ASSERT_EQ(region_len, 22);
+    for (size_t i = 0; i < region_len; i++)
+    {
+        EXPECT_EQ(region[i], data_in[10 + i]);
+    }
+    ASSERT_TRUE(circular_buffer_consume(&ctx, region_len));
+
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+    ASSERT_FALSE(circular_buffer_peek_contiguous(&ctx, &region, &region_len));
+}
+
+TEST_F(CircularBufferTest, CommitAndConsumeRejectTooMuch)
+{
+    ASSERT_FALSE(circular_buffer_consume(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_commit(&ctx, buff_size + 1));
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+
+    ASSERT_TRUE(circular_buffer_commit(&ctx, buff_size));
+    ASSERT_FALSE(circular_buffer_commit(&ctx, 1));
+    ASSERT_FALSE(circular_buffer_consume(&ctx, buff_size + 1));
+    ASSERT_TRUE(circular_buffer_is_full(&ctx));
+}
+
+/****************** SECTION: Watermarks ************************/
+
+// Records every watermark event fired into it.
+struct watermark_log {
+    std::vector<circular_buffer_watermark_event> events;
+    std::vector<size_t> byte_counts;
+};
+
+static void record_watermark(circular_buffer_watermark_event event, size_t byte_count, void *arg)
+{
+    watermark_log *log = (watermark_log *)arg;
+    log->events.push_back(event);
+    log->byte_counts.push_back(byte_count);
+}
+
+TEST_F(CircularBufferTest, SetWatermarksRejectsInvalidArguments)
+{
+    watermark_log log;
+    ASSERT_FALSE(circular_buffer_set_watermarks(NULL, 0, 8, record_watermark, &log));
+    ASSERT_FALSE(circular_buffer_set_watermarks(&ctx, 8, 8, record_watermark, &log));
+    ASSERT_FALSE(circular_buffer_set_watermarks(&ctx, 0, 0, record_watermark, &log));
+    ASSERT_FALSE(circular_buffer_set_watermarks(&ctx, 0, buff_size + 1, record_watermark, &log));
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 0, buff_size, record_watermark, &log));
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 0, buff_size, NULL, NULL));
+
+    // Removing the watermarks takes any thresholds.
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 8, 8, NULL, NULL));
+    ASSERT_FALSE(circular_buffer_set_watermarks(NULL, 0, 0, NULL, NULL));
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 0, buff_size, record_watermark, &log));
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 0, 0, NULL, NULL));
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_TRUE(log.events.empty());
+}
+
+TEST_F(CircularBufferTest, WatermarksFireOncePerCrossing)
+{
+    watermark_log log;
+    uint8_t data_out = 0;
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 4, 64, record_watermark, &log));
+
+    // Filling byte by byte fires HIGH once, on the byte that reaches the watermark.
+    for (size_t i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_EQ(log.events.size(), 1);
+    EXPECT_EQ(log.events[0], CIRCULAR_BUFFER_WATERMARK_HIGH);
+    EXPECT_EQ(log.byte_counts[0], 64);
+
+    // Draining below high does not fire. Reaching low fires LOW once.
+    for (size_t i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    }
+    ASSERT_EQ(log.events.size(), 2);
+    EXPECT_EQ(log.events[1], CIRCULAR_BUFFER_WATERMARK_LOW);
+    EXPECT_EQ(log.byte_counts[1], 4);
+
+    // Re-armed: the next batch fires HIGH again.
+    for (size_t i = 0; i < 64; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_with_overwrite(&ctx, (uint8_t)i));
+    }
+    ASSERT_EQ(log.events.size(), 3);
+    EXPECT_EQ(log.events[2], CIRCULAR_BUFFER_WATERMARK_HIGH);
+}
+
+TEST_F(CircularBufferTest, WatermarksFireFromBulkAndZeroCopyPaths)
+{
+    watermark_log log;
+    std::vector<uint8_t> block(200, 0xAB);
+    uint8_t *region = NULL;
+    size_t region_len = 0;
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 16, 128, record_watermark, &log));
+
+    // A single write that jumps past the watermark fires once.
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), block.size(), false));
+    ASSERT_EQ(log.events.size(), 1);
+    EXPECT_EQ(log.byte_counts[0], 200);
+
+    ASSERT_TRUE(circular_buffer_read(&ctx, block.data(), 150));
+    EXPECT_EQ(log.events.size(), 1);
+    ASSERT_TRUE(circular_buffer_consume(&ctx, 50));
+    ASSERT_EQ(log.events.size(), 2);
+    EXPECT_EQ(log.events[1], CIRCULAR_BUFFER_WATERMARK_LOW);
+
+    ASSERT_TRUE(circular_buffer_reserve(&ctx, &region, &region_len));
+    ASSERT_TRUE(circular_buffer_commit(&ctx, 128));
+    ASSERT_EQ(log.events.size(), 3);
+    EXPECT_EQ(log.events[2], CIRCULAR_BUFFER_WATERMARK_HIGH);
+}
+
+TEST_F(CircularBufferTest, WatermarksFireFromUncheckedPath)
+{
+    watermark_log log;
+    uint8_t data_out = 0;
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 0, 2, record_watermark, &log));
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite_unchecked(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_push_with_overwrite_unchecked(&ctx, 2));
+    ASSERT_TRUE(circular_buffer_pop_unchecked(&ctx, &data_out));
+    ASSERT_TRUE(circular_buffer_pop_unchecked(&ctx, &data_out));
+    EXPECT_EQ(log.events, (std::vector<circular_buffer_watermark_event>{
+        CIRCULAR_BUFFER_WATERMARK_HIGH, CIRCULAR_BUFFER_WATERMARK_LOW }));
+}
+
+TEST_F(CircularBufferTest, WatermarksStartFromCurrentFillLevel)
+{
+    watermark_log log;
+    uint8_t data_out = 0;
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    }
+
+    // Already above high: nothing fires on registration, the next crossing is LOW.
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 5, 8, record_watermark, &log));
+    EXPECT_TRUE(log.events.empty());
+    for (size_t i = 0; i < 5; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    }
+    ASSERT_EQ(log.events.size(), 1);
+    EXPECT_EQ(log.events[0], CIRCULAR_BUFFER_WATERMARK_LOW);
+
+    // Removing the callback stops the events.
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 5, 8, NULL, NULL));
+    for (size_t i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    }
+    EXPECT_EQ(log.events.size(), 1);
+}
+
+TEST_F(CircularBufferTest, ClearFiresLowWatermark)
+{
+    watermark_log log;
+    std::vector<uint8_t> block(100, 0);
+
+    ASSERT_TRUE(circular_buffer_set_watermarks(&ctx, 10, 50, record_watermark, &log));
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), block.size(), false));
+    ASSERT_TRUE(circular_buffer_clear(&ctx));
+    EXPECT_EQ(log.events, (std::vector<circular_buffer_watermark_event>{
+        CIRCULAR_BUFFER_WATERMARK_HIGH, CIRCULAR_BUFFER_WATERMARK_LOW }));
+}
+
+/****************** SECTION: Statistics ************************/
+
+#ifdef CIRCULAR_BUFFER_ENABLE_STATS
+
+TEST_F(CircularBufferTest, StatsHandleNullArguments)
+{
+    circular_buffer_stats stats;
+    ASSERT_FALSE(circular_buffer_get_stats(NULL, &stats));
+    ASSERT_FALSE(circular_buffer_get_stats(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_get_and_clear_stats(NULL, &stats));
+    ASSERT_FALSE(circular_buffer_get_and_clear_stats(&ctx, NULL));
+}
+
+TEST_F(CircularBufferTest, StatsCountEveryPath)
+{
+    circular_buffer_stats stats;
+    std::vector<uint8_t> block(100, 0);
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_get_stats(&ctx, &stats));
+    EXPECT_EQ(stats.bytes_pushed, 0);
+    EXPECT_EQ(stats.high_water, 0);
+
+    // 100 + 1 + 150 bytes in, reaching 251.
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), block.size(), false));
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_commit(&ctx, 150));
+
+    // 1 + 50 + 100 + 10 bytes out.
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    ASSERT_TRUE(circular_buffer_read(&ctx, block.data(), 50));
+    ASSERT_TRUE(circular_buffer_consume(&ctx, 100));
+    ASSERT_TRUE(circular_buffer_skip(&ctx, 10));
+
+    // 90 stored. Refused calls count once each, but a read of more than is stored
+    // is not an empty pop.
+    ASSERT_FALSE(circular_buffer_read(&ctx, block.data(), 91));
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), 100, true));
+    ASSERT_FALSE(circular_buffer_write(&ctx, block.data(), 100, false));
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), 66, true));
+    ASSERT_FALSE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_push_with_overwrite(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_clear(&ctx));
+    ASSERT_FALSE(circular_buffer_pop(&ctx, &data_out));
+    ASSERT_FALSE(circular_buffer_read(&ctx, block.data(), 1));
+
+    // Clear drops a full buffer, so every byte pushed is accounted for.
+    ASSERT_TRUE(circular_buffer_get_stats(&ctx, &stats));
+    EXPECT_EQ(stats.bytes_pushed, 251 + 100 + 66 + 1);
+    EXPECT_EQ(stats.bytes_popped, 161 + buff_size);
+    EXPECT_EQ(stats.bytes_overwritten, 1);
+    EXPECT_EQ(stats.bytes_pushed, stats.bytes_popped + stats.bytes_overwritten);
+    EXPECT_EQ(stats.rejected_pushes, 2);
+    EXPECT_EQ(stats.empty_pops, 2);
+    EXPECT_EQ(stats.high_water, buff_size);
+}
+
+TEST_F(CircularBufferTest, StatsKeepCountingPast32Bits)
+{
+    circular_buffer_stats stats;
+
+    ctx.stats.bytes_pushed = UINT32_MAX;
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_get_stats(&ctx, &stats));
+    EXPECT_EQ(stats.bytes_pushed, (uint64_t)UINT32_MAX + 1);
+}
+
+TEST_F(CircularBufferTest, GetAndClearStatsRestartsFromCurrentLevel)
+{
+    circular_buffer_stats stats;
+    uint8_t data_out = 0;
+
+    for (size_t i = 0; i < 30; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    }
+    for (size_t i = 0; i < 20; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    }
+
+    ASSERT_TRUE(circular_buffer_get_and_clear_stats(&ctx, &stats));
+    EXPECT_EQ(stats.bytes_pushed, 30);
+    EXPECT_EQ(stats.bytes_popped, 20);
+    EXPECT_EQ(stats.high_water, 30);
+
+    ASSERT_TRUE(circular_buffer_get_stats(&ctx, &stats));
+    EXPECT_EQ(stats.bytes_pushed, 0);
+    EXPECT_EQ(stats.bytes_popped, 0);
+    EXPECT_EQ(stats.high_water, 10);
+}
+
+#else
+
+TEST_F(CircularBufferTest, StatsUnavailableWhenDisabled)
+{
+    circular_buffer_stats stats;
+    ASSERT_FALSE(circular_buffer_get_stats(&ctx, &stats));
+    ASSERT_FALSE(circular_buffer_get_and_clear_stats(&ctx, &stats));
+}
+
+#endif
+
+/****************** SECTION: Latency ************************/
+
+#ifdef CIRCULAR_BUFFER_ENABLE_LATENCY
+
+// A clock that only moves when the test says so.
+static uint64_t fake_clock(void *arg)
+{
+    return *(uint64_t *)arg;
+}
+
+TEST_F(CircularBufferTest, LatencyHandlesInvalidArguments)
+{
+    circular_buffer_latency_histogram histogram;
+    uint64_t now = 0;
+
+    ASSERT_FALSE(circular_buffer_set_latency_clock(NULL, fake_clock, &now, 1));
+    ASSERT_FALSE(circular_buffer_set_latency_clock(&ctx, fake_clock, &now, 0));
+    ASSERT_FALSE(circular_buffer_set_latency_clock(NULL, NULL, NULL, 0));
+    ASSERT_FALSE(circular_buffer_get_latency(NULL, &histogram));
+    ASSERT_FALSE(circular_buffer_get_latency(&ctx, NULL));
+    ASSERT_FALSE(circular_buffer_get_and_clear_latency(NULL, &histogram));
+    ASSERT_FALSE(circular_buffer_get_and_clear_latency(&ctx, NULL));
+}
+
+TEST_F(CircularBufferTest, LatencyRecordsNothingWithoutClock)
+{
+    circular_buffer_latency_histogram histogram;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 0);
+}
+
+TEST_F(CircularBufferTest, LatencyClearingClockIgnoresBatchSize)
+{
+    circular_buffer_latency_histogram histogram;
+    uint64_t now = 0;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_set_latency_clock(&ctx, fake_clock, &now, 1));
+    ASSERT_TRUE(circular_buffer_set_latency_clock(&ctx, NULL, NULL, 0));
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 1));
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 0);
+}
+
+TEST_F(CircularBufferTest, LatencyBucketsAreLog2)
+{
+    circular_buffer_latency_histogram histogram;
+    uint64_t now = 0;
+    uint8_t data_out = 0;
+    const uint64_t residencies[] = {0, 1, 2, 3, 4, 1000, UINT64_MAX / 2};
+
+    ASSERT_TRUE(circular_buffer_set_latency_clock(&ctx, fake_clock, &now, 1));
+    for (uint64_t residency : residencies)
+    {
+        now = 5;
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+        now += residency;
+        ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    }
+
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 7);
+    EXPECT_EQ(histogram.max, UINT64_MAX / 2);
+    EXPECT_EQ(histogram.buckets[0], 1);    // 0
+    EXPECT_EQ(histogram.buckets[1], 1);    // 1
+    EXPECT_EQ(histogram.buckets[2], 2);    // 2, 3
+    EXPECT_EQ(histogram.buckets[3], 1);    // 4
+    EXPECT_EQ(histogram.buckets[10], 1);   // 1000
+    EXPECT_EQ(histogram.buckets[CIRCULAR_BUFFER_LATENCY_BUCKETS - 1], 1);  // Saturated
+}
+
+TEST_F(CircularBufferTest, LatencySamplesOncePerBatch)
+{
+    circular_buffer_latency_histogram histogram;
+    std::vector<uint8_t> block(16, 0);
+    uint64_t now = 0;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_set_latency_clock(&ctx, fake_clock, &now, 16));
+
+    // Two batches: bytes 0-15 from t=10 and 16-31 from t=20. The pushes at t=11 join the first.
+    now = 10;
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), 8, false));
+    now = 11;
+    for (size_t i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    }
+    now = 20;
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), 16, false));
+
+    // A batch is only sampled once its last byte is gone.
+    now = 100;
+    ASSERT_TRUE(circular_buffer_read(&ctx, block.data(), 15));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 0);
+
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 1);
+    EXPECT_EQ(histogram.max, 90);
+
+    now = 200;
+    ASSERT_TRUE(circular_buffer_consume(&ctx, 16));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 2);
+    EXPECT_EQ(histogram.max, 180);
+}
+
+TEST_F(CircularBufferTest, LatencyCountsOverwrittenAndClearedBytes)
+{
+    circular_buffer_latency_histogram histogram;
+    std::vector<uint8_t> block(buff_size, 0);
+    uint64_t now = 0;
+
+    ASSERT_TRUE(circular_buffer_set_latency_clock(&ctx, fake_clock, &now, buff_size));
+
+    // Filling the buffer starts one batch, overwriting its oldest byte starts the next.
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), buff_size, false));
+    now = 7;
+    ASSERT_TRUE(circular_buffer_push_with_overwrite(&ctx, 0));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 0);
+
+    // Overwriting the rest of the first batch retires it.
+    now = 9;
+    ASSERT_TRUE(circular_buffer_write(&ctx, block.data(), buff_size - 1, true));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 1);
+    EXPECT_EQ(histogram.max, 9);
+
+    now = 12;
+    ASSERT_TRUE(circular_buffer_clear(&ctx));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 2);
+    EXPECT_EQ(histogram.max, 9);
+}
+
+TEST_F(CircularBufferTest, LatencyFoldsBatchesWhenMarksRunOut)
+{
+    circular_buffer_latency_histogram histogram;
+    uint64_t now = 0;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_set_latency_clock(&ctx, fake_clock, &now, 1));
+    for (size_t i = 0; i < CIRCULAR_BUFFER_LATENCY_MARKS + 4; i++)
+    {
+        now = i;
+        ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    }
+
+    now = 100;
+    while (circular_buffer_pop(&ctx, &data_out))
+    {
+    }
+
+    // The extra bytes joined the newest batch instead of going untimed.
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, CIRCULAR_BUFFER_LATENCY_MARKS);
+    EXPECT_EQ(histogram.max, 100);
+}
+
+TEST_F(CircularBufferTest, GetAndClearLatencyKeepsBatchesInFlight)
+{
+    circular_buffer_latency_histogram histogram;
+    uint64_t now = 0;
+    uint8_t data_out = 0;
+
+    ASSERT_TRUE(circular_buffer_set_latency_clock(&ctx, fake_clock, &now, 1));
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 0));
+    now = 3;
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+
+    ASSERT_TRUE(circular_buffer_get_and_clear_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 1);
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 0);
+
+    now = 5;
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    ASSERT_TRUE(circular_buffer_get_latency(&ctx, &histogram));
+    EXPECT_EQ(histogram.samples, 1);
+    EXPECT_EQ(histogram.max, 5);
+    EXPECT_EQ(histogram.buckets[3], 1);
+}
+
+#else
+
+TEST_F(CircularBufferTest, LatencyUnavailableWhenDisabled)
+{
+    circular_buffer_latency_histogram histogram;
+    uint64_t now = 0;
+    ASSERT_FALSE(circular_buffer_set_latency_clock(&ctx, NULL, &now, 1));
+    ASSERT_FALSE(circular_buffer_get_latency(&ctx, &histogram));
+    ASSERT_FALSE(circular_buffer_get_and_clear_latency(&ctx, &histogram));
+}
+
+#endif
+
+/****************** SECTION: Unchecked Hot Path ************************/
+
+TEST_F(CircularBufferTest, UncheckedVariantsMatchCheckedApi)
+{
+    circular_buffer_ctx checked_ctx;
+    std::vector<uint8_t> checked_storage(buff_size);
+    ASSERT_TRUE(circular_buffer_init_with_storage(&checked_ctx, checked_storage.data(), buff_size));
+    ASSERT_TRUE(circular_buffer_ctx_is_valid(&ctx)); // Validate once, as a caller would.
+
+    for (size_t i = 0; i < 10 * buff_size; i++)
+    {
+        uint8_t data_in = random_uint8();
+        uint8_t data_out = 0, checked_data_out = 0;
+
+        switch (rand() % 4)
+        {
+            case 0:
+                ASSERT_TRUE(circular_buffer_push_with_overwrite_unchecked(&ctx, data_in));
+                ASSERT_TRUE(circular_buffer_push_with_overwrite(&checked_ctx, data_in));
+                break;
+            case 1:
+                ASSERT_EQ(circular_buffer_push_no_overwrite_unchecked(&ctx, data_in),
+                          circular_buffer_push_no_overwrite(&checked_ctx, data_in));
+                break;
+            case 2:
+                ASSERT_EQ(circular_buffer_peek_unchecked(&ctx, &data_out),
+                          circular_buffer_peek(&checked_ctx, &checked_data_out));
+                EXPECT_EQ(data_out, checked_data_out);
+                break;
+            default:
+                ASSERT_EQ(circular_buffer_pop_unchecked(&ctx, &data_out),
+                          circular_buffer_pop(&checked_ctx, &checked_data_out));
+                EXPECT_EQ(data_out, checked_data_out);
+                break;
+        }
+
+        ASSERT_EQ(circular_buffer_is_empty_unchecked(&ctx), circular_buffer_is_empty(&checked_ctx));
+        ASSERT_EQ(circular_buffer_is_full_unchecked(&ctx), circular_buffer_is_full(&checked_ctx));
+    }
+}
+
+TEST_F(CircularBufferTest, CtxIsValidRejectsCorruptCtx)
+{
+    circular_buffer_ctx corrupt_ctx = ctx;
+    ASSERT_FALSE(circular_buffer_ctx_is_valid(NULL));
+    ASSERT_TRUE(circular_buffer_ctx_is_valid(&corrupt_ctx));
+    corrupt_ctx.current_byte_count = buff_size + 1; // more bytes than fit
+    ASSERT_FALSE(circular_buffer_ctx_is_valid(&corrupt_ctx));
+}
+
 /****************** SECTION: Fault Handling and Edge Cases ************************/
 
 TEST_F(CircularBufferTest, PopFailsForFreshBuffer)
@@ -632,7 +1640,7 @@ TEST_F(CircularBufferTest, PopProtectsAgainstCorruptCtx)
 {
     uint8_t data_out = 0;
     circular_buffer_ctx corrupt_ctx = ctx;
-    corrupt_ctx.tail = CIRCULAR_BUFFER_MAX_SIZE; // out of bounds index
+    corrupt_ctx.tail = buff_size; // out of bounds index
     ASSERT_FALSE(circular_buffer_pop(&corrupt_ctx, &data_out));
 }
 
@@ -640,7 +1648,7 @@ TEST_F(CircularBufferTest, PushProtectsAgainstCorruptCtx)
 {
     uint8_t data_in = 0;
     circular_buffer_ctx corrupt_ctx = ctx;
-    corrupt_ctx.head = CIRCULAR_BUFFER_MAX_SIZE; // out of bounds index
+    corrupt_ctx.head = buff_size; // out of bounds index
     ASSERT_FALSE(circular_buffer_push_with_overwrite(&corrupt_ctx, data_in));
 }
 
@@ -648,7 +1656,7 @@ TEST_F(CircularBufferTest, PushNoOverwriteProtectsAgainstCorruptCtx)
 {
     uint8_t data_in = 0;
     circular_buffer_ctx corrupt_ctx = ctx;
-    corrupt_ctx.head = CIRCULAR_BUFFER_MAX_SIZE; // out of bounds index
+    corrupt_ctx.head = buff_size; // out of bounds index
     ASSERT_FALSE(circular_buffer_push_no_overwrite(&corrupt_ctx, data_in));
 }
 
@@ -656,6 +1664,52 @@ TEST_F(CircularBufferTest, PeekProtectsAgainstCorruptCtx)
 {
     uint8_t data_out = 0;
     circular_buffer_ctx corrupt_ctx = ctx;
-    corrupt_ctx.tail = CIRCULAR_BUFFER_MAX_SIZE; // out of bounds index
+    corrupt_ctx.tail = buff_size; // out of bounds index
     ASSERT_FALSE(circular_buffer_peek(&corrupt_ctx, &data_out));
 }
+
+TEST_F(CircularBufferTest, WriteNoOverwriteFailsWithoutRoom)
+{
+    uint8_t data_in[buff_size] = { 0 };
+    uint8_t data_out = 0;
+    uint32_t overflow_count = 0;
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 7));
+
+    // The whole block no longer fits, so none of it may be written.
+    ASSERT_FALSE(circular_buffer_write(&ctx, data_in, buff_size, false));
+
+    ASSERT_TRUE(circular_buffer_get_overflow_count(&ctx, &overflow_count));
+    EXPECT_EQ(overflow_count, 0);
+    ASSERT_TRUE(circular_buffer_pop(&ctx, &data_out));
+    EXPECT_EQ(data_out, 7);
+    ASSERT_TRUE(circular_buffer_is_empty(&ctx));
+}
+
+TEST_F(CircularBufferTest, ReadFailsWithoutEnoughData)
+{
+    uint8_t data_out[2] = { 0 };
+
+    ASSERT_TRUE(circular_buffer_push_no_overwrite(&ctx, 7));
+    ASSERT_FALSE(circular_buffer_read(&ctx, data_out, sizeof(data_out)));
+
+    // The byte that was there must not have been consumed.
+    ASSERT_TRUE(circular_buffer_read(&ctx, data_out, 1));
+    EXPECT_EQ(data_out[0], 7);
+}
+
+TEST_F(CircularBufferTest, WriteProtectsAgainstCorruptCtx)
+{
+    uint8_t data_in[4] = { 0 };
+    circular_buffer_ctx corrupt_ctx = ctx;
+    corrupt_ctx.head = buff_size; // out of bounds index
+    ASSERT_FALSE(circular_buffer_write(&corrupt_ctx, data_in, sizeof(data_in), true));
+}
+
+TEST_F(CircularBufferTest, ReadProtectsAgainstCorruptCtx)
+{
+    uint8_t data_out[4] = { 0 };
+    circular_buffer_ctx corrupt_ctx = ctx;
+    corrupt_ctx.tail = buff_size; // out of bounds index
+    ASSERT_FALSE(circular_buffer_read(&corrupt_ctx, data_out, 1));
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <stdbool.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "circular_buffer_wait.h"
+}
+
+class CircularBufferWaitTest : public ::testing::Test {
+protected:
+    size_t buff_size = 4;
+    std::vector<uint8_t> storage = std::vector<uint8_t>(buff_size);  // Caller storage works in every build
+    circular_buffer_wait_ctx ctx;
+
+    void SetUp() override {
+        ASSERT_TRUE(circular_buffer_wait_init_with_storage(&ctx, storage.data(), storage.size()));
+    }
+};
+
+/****************** SECTION: Initialization ************************/
+
+TEST(CircularBufferWaitInitTest, InitHandlesInvalidArguments)
+{
+    circular_buffer_wait_ctx ctx;
+    uint8_t storage[8] = { 0 };
+
+    ASSERT_FALSE(circular_buffer_wait_init(NULL, 8));
+    ASSERT_FALSE(circular_buffer_wait_init(&ctx, 0));
+    ASSERT_FALSE(circular_buffer_wait_init(&ctx, CIRCULAR_BUFFER_MAX_SIZE + 1));
+    ASSERT_FALSE(circular_buffer_wait_init_with_storage(NULL, storage, sizeof(storage)));
+    ASSERT_FALSE(circular_buffer_wait_init_with_storage(&ctx, NULL, sizeof(storage)));
+    ASSERT_TRUE(circular_buffer_wait_init_with_storage(&ctx, storage, sizeof(storage)));
+}
+
+/****************** SECTION: NULL Inputs ************************/
+
+TEST_F(CircularBufferWaitTest, HandlesNullArguments)
+{
+    uint8_t data = 0;
+    ASSERT_FALSE(circular_buffer_push_wait(NULL, data, 0));
+    ASSERT_FALSE(circular_buffer_pop_wait(NULL, &data, 0));
+    ASSERT_FALSE(circular_buffer_pop_wait(&ctx, NULL, 0));
+}
+
+/****************** SECTION: Basic Usage ************************/
+
+TEST_F(CircularBufferWaitTest, ZeroTimeoutDoesNotBlock)
+{
+    uint8_t data_out = 0;
+
+    ASSERT_FALSE(circular_buffer_pop_wait(&ctx, &data_out, 0));
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_wait(&ctx, (uint8_t)i, 0));
+    }
+    ASSERT_FALSE(circular_buffer_push_wait(&ctx, 0xFF, 0));
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_pop_wait(&ctx, &data_out, 0));
+        EXPECT_EQ(data_out, (uint8_t)i);
+    }
+}
+
+TEST_F(CircularBufferWaitTest, TimesOutWhenNothingHappens)
+{
+    uint8_t data_out = 0;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(circular_buffer_pop_wait(&ctx, &data_out, 20));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_wait(&ctx, 0, 0));
+    }
+    start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(circular_buffer_push_wait(&ctx, 0, 20));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST_F(CircularBufferWaitTest, WaitingConsumerIsWokenByPush)
+{
+    uint8_t data_out = 0;
+
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        (void)circular_buffer_push_wait(&ctx, 42, 0);
+    });
+
+    ASSERT_TRUE(circular_buffer_pop_wait(&ctx, &data_out, CIRCULAR_BUFFER_WAIT_FOREVER));
+    EXPECT_EQ(data_out, 42);
+    producer.join();
+}
+
+TEST_F(CircularBufferWaitTest, WaitingProducerIsWokenByPop)
+{
+    for (size_t i = 0; i < buff_size; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_wait(&ctx, (uint8_t)i, 0));
+    }
+
+    std::thread consumer([&]() {
+        uint8_t data_out = 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        (void)circular_buffer_pop_wait(&ctx, &data_out, 0);
+    });
+
+    ASSERT_TRUE(circular_buffer_push_wait(&ctx, 0xFF, 5000));
+    consumer.join();
+}
+
+/****************** SECTION: Concurrency ************************/
+
+TEST_F(CircularBufferWaitTest, MultiThreadedStressTest)
+{
+    // A four byte buffer keeps both sides parking and waking each other.
+    const size_t total_bytes = 200000;
+    size_t mismatches = 0;
+
+    std::thread consumer([&]() {
+        for (size_t i = 0; i < total_bytes; i++)
+        {
+            uint8_t data_out = 0;
+            if (!circular_buffer_pop_wait(&ctx, &data_out, CIRCULAR_BUFFER_WAIT_FOREVER) ||
+                data_out != (uint8_t)(i * 31))
+            {
+                mismatches++;
+            }
+        }
+    });
+
+    for (size_t i = 0; i < total_bytes; i++)
+    {
+        ASSERT_TRUE(circular_buffer_push_wait(&ctx, (uint8_t)(i * 31), CIRCULAR_BUFFER_WAIT_FOREVER));
+    }
+
+    consumer.join();
+    EXPECT_EQ(mismatches, 0);
+}
+
+/****************** SECTION: Fault Handling and Edge Cases ************************/
+
+TEST_F(CircularBufferWaitTest, InvalidRingFailsInsteadOfWaiting)
+{
+    uint8_t data_out = 0;
+
+    // A full or empty ring would wait forever here. An invalid one must not.
+    ctx.ring.buffer = NULL;
+    ASSERT_FALSE(circular_buffer_push_wait(&ctx, 1, CIRCULAR_BUFFER_WAIT_FOREVER));
+    ASSERT_FALSE(circular_buffer_pop_wait(&ctx, &data_out, CIRCULAR_BUFFER_WAIT_FOREVER));
+}